@@ -1,15 +1,48 @@
+#include <algorithm>
+#include <chrono>
 #include <cstddef>
 #include <cstring>
 #include <exception>
+#include <fstream>
 #include <iostream>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <random>
 #include <sstream>
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "s21_memory.h"
 #include "s21_memory.hpp"
 #include "s21_memory/block.hpp"
+#include "s21_memory/buddy_allocator.hpp"
+#include "s21_memory/size_classes.hpp"
+
+/// Latencies of executed commands by command name, only recorded in batch
+/// mode, where they are summarised
+std::map<std::string, std::vector<std::chrono::nanoseconds>> command_latencies;
+
+bool record_latencies = false;
+
+std::mt19937 random_engine(21);
+
+constexpr auto default_buddy_heap_size = 4096ul;
+
+/// Heap of the buddy engine, heap and allocation commands use it while the
+/// engine is selected
+std::optional<s21::memory::buddy_allocator> buddy_heap;
+
+bool buddy_selected = false;
+
+/// Commands which only work with the default engine
+std::unordered_set<std::string> default_only_commands = {
+    "block_of", "malloc_hint", "malloc_shared", "retain", "release",
+    "freeze", "malloc_purgeable", "pin", "unpin", "merge_free", "trim",
+    "stats"};
 
 std::unordered_map<s21::memory::block_type, std::size_t> type_sizes = {
     {s21::memory::block_type::char_t, sizeof(char)},
@@ -17,6 +50,12 @@ std::unordered_map<s21::memory::block_type, std::size_t> type_sizes = {
     {s21::memory::block_type::double_t, sizeof(double)},
 };
 
+std::unordered_map<std::string, s21_lifetime> lifetime_names = {
+    {"short", S21_LIFETIME_SHORT},
+    {"long", S21_LIFETIME_LONG},
+    {"permanent", S21_LIFETIME_PERMANENT},
+};
+
 std::unordered_map<std::string, s21::memory::block_type> type_names = {
     {"char", s21::memory::block_type::char_t},
     {"int", s21::memory::block_type::int_t},
@@ -34,6 +73,17 @@ auto print_block_info(s21::memory::block_header* block) {
     return;
   }
 
+  std::cout << "\tlifetime: " << static_cast<int>(block->lifetime) << "\n";
+
+  if (auto references = block->references.load()) {
+    std::cout << "\treferences: " << std::dec << references << "\n"
+              << "\tfrozen: " << block->frozen.load() << "\n";
+  }
+
+  if (block->purgeable) {
+    std::cout << "\tpurgeable: 1\n";
+  }
+
   auto element_size = type_sizes[block->type];
 
   auto start = s21::memory::data_of(block);
@@ -74,34 +124,127 @@ auto print_block_info(s21::memory::block_header* block) {
   std::cout << "}\n";
 }
 
-auto print_memory_layout(s21::memory::allocator& allocator) {
+template <typename Engine>
+auto print_memory_layout(Engine& allocator) {
   std::cout << "heap layout [" << std::dec << allocator.size() << "]:\n";
 
   for (auto& block : allocator.blocks()) {
     print_block_info(block);
   }
 
-  std::cout << std::dec << std::endl;
+  std::cout << std::dec << "\n";
+}
+
+/**
+ * @brief Returns the buddy heap, creating it on first use like s21_malloc
+ */
+auto buddy() -> s21::memory::buddy_allocator& {
+  if (!buddy_heap) {
+    buddy_heap.emplace(default_buddy_heap_size);
+  }
+
+  return *buddy_heap;
+}
+
+auto engine_malloc(std::size_t size) -> void* {
+  if (!buddy_selected) {
+    return s21_malloc(size);
+  }
+
+  auto block = buddy().try_allocate_block(size);
+
+  return block ? s21::memory::data_of(block) : nullptr;
+}
+
+auto engine_calloc(std::size_t n, std::size_t size) -> void* {
+  if (!buddy_selected) {
+    return s21_calloc(n, size);
+  }
+
+  std::size_t total;
+
+  if (n == 0 || size == 0 || __builtin_mul_overflow(n, size, &total)) {
+    return nullptr;
+  }
+
+  auto result = engine_malloc(total);
+
+  if (result) {
+    std::memset(result, 0, total);
+  }
+
+  return result;
+}
+
+auto engine_realloc(void* address, std::size_t size) -> void* {
+  if (!buddy_selected) {
+    return s21_realloc(address, size);
+  }
+
+  if (!address) {
+    return engine_malloc(size);
+  }
+
+  auto block =
+      buddy().try_reallocate_block(s21::memory::header_of(address), size);
+
+  return block ? s21::memory::data_of(block) : nullptr;
+}
+
+auto engine_free(void* address) {
+  if (!buddy_selected) {
+    s21_free(address);
+    return;
+  }
+
+  if (address) {
+    buddy().free_block(s21::memory::header_of(address));
+  }
 }
 
 auto handle_help(std::istringstream&) {
   std::cout
       << "available commands:\n"
+         "\tengine [default|buddy] - selects the engine behind heap, "
+         "set_heap, malloc, calloc, realloc, free and random_free\n"
          "\tset_heap <size> - allocates a new heap with the specified size\n"
          "\theap - displays current heap layout\n"
          "\tblock <address> - displays info about the specified memory block\n"
+         "\tblock_of <address> - finds the allocated block containing the "
+         "address\n"
          "\tmalloc <size> - calls s21_malloc for current heap\n"
+         "\tmalloc_hint <size> <short|long|permanent> - calls s21_malloc_hint "
+         "for current heap\n"
          "\tcalloc <n> <size> - calls s21_calloc for current heap\n"
          "\trealloc <address> <size> - calls s21_realloc for current heap\n"
          "\tfree <address> - calls s21_free for current heap\n"
+         "\tmalloc_shared <size> - calls s21_malloc_shared for current heap\n"
+         "\tretain <address> - adds a reference to a shared block\n"
+         "\trelease <address> - drops a reference to a shared block\n"
+         "\tfreeze <address> - marks a shared block read-only\n"
+         "\tmalloc_purgeable <size> - calls s21_malloc_purgeable for current "
+         "heap\n"
+         "\tpin <address> - pins a purgeable block\n"
+         "\tunpin <address> - unpins a purgeable block, it may be reclaimed "
+         "afterwards\n"
          "\tmerge_free - merges adjacent free blocks\n"
+         "\ttrim - returns free pages to the OS\n"
+         "\tset_decay <ms> - sets the delay before free pages are purged\n"
+         "\tstats - displays heap size and placement of each lifetime class\n"
+         "\tsize_classes - displays learned size classes and their efficiency\n"
+         "\tset_size_classes [sizes...] - replaces the size class table\n"
+         "\trepeat <n> <command> - runs the command n times\n"
+         "\trandom_free <percent> - frees the percentage of allocated blocks "
+         "at random\n"
+         "\tresearch <percent> - refills a heap after freeing random blocks "
+         "with each allocator engine\n"
          "\tset <address> <type> = <value> - assigns a single value by the "
          "specified address\n"
          "\tset <address> <type> [] <length> [values...] - assigns an array of "
          "values by the specified address\n"
          "\thelp - displays this message\n"
          "\texit - exits the repl\n"
-      << std::endl;
+         "\n";
 }
 
 auto handle_set_heap(std::istringstream& argv) {
@@ -109,14 +252,47 @@ auto handle_set_heap(std::istringstream& argv) {
 
   argv >> size;
 
-  s21::set_heap(size);
+  if (buddy_selected) {
+    buddy_heap.emplace(size);
+  } else {
+    s21::set_heap(size);
+  }
 
-  std::cout << "ok " << size << std::endl;
+  std::cout << "ok " << size << "\n";
+}
+
+auto handle_engine(std::istringstream& argv) {
+  std::string name;
+
+  if (!(argv >> name)) {
+    std::cout << (buddy_selected ? "buddy" : "default") << "\n";
+    return;
+  }
+
+  if (name != "default" && name != "buddy") {
+    std::cout << "invalid engine '" << name << "'\n";
+    return;
+  }
+
+  buddy_selected = name == "buddy";
+
+  std::cout << "ok " << name << "\n";
 }
 
 auto handle_heap(std::istringstream&) {
+  if (buddy_selected) {
+    if (!buddy_heap) {
+      std::cout << "(none)\n";
+      return;
+    }
+
+    print_memory_layout(*buddy_heap);
+
+    return;
+  }
+
   if (!s21::memory::internal::default_allocator) {
-    std::cout << "(none)" << std::endl;
+    std::cout << "(none)\n";
 
     return;
   }
@@ -132,14 +308,46 @@ auto handle_block(std::istringstream& argv) {
   print_block_info(s21::memory::header_of(address));
 }
 
+auto handle_block_of(std::istringstream& argv) {
+  void* address;
+
+  argv >> address;
+
+  auto result = s21_block_of(address);
+
+  if (!result) {
+    std::cout << "(none)\n";
+
+    return;
+  }
+
+  std::cout << "ok " << std::hex << result << "\n";
+}
+
 auto handle_malloc(std::istringstream& argv) {
   std::size_t size;
 
   argv >> size;
 
-  auto result = s21_malloc(size);
+  auto result = engine_malloc(size);
+
+  std::cout << "ok " << std::hex << result << "\n";
+}
+
+auto handle_malloc_hint(std::istringstream& argv) {
+  std::size_t size;
+  std::string lifetime;
+
+  argv >> size >> lifetime;
+
+  if (lifetime_names.count(lifetime) == 0) {
+    std::cout << "invalid lifetime '" << lifetime << "'\n";
+    return;
+  }
+
+  auto result = s21_malloc_hint(size, lifetime_names[lifetime]);
 
-  std::cout << "ok " << std::hex << result << std::endl;
+  std::cout << "ok " << std::hex << result << "\n";
 }
 
 auto handle_calloc(std::istringstream& argv) {
@@ -148,9 +356,9 @@ auto handle_calloc(std::istringstream& argv) {
 
   argv >> n >> size;
 
-  auto result = s21_calloc(n, size);
+  auto result = engine_calloc(n, size);
 
-  std::cout << "ok " << std::hex << result << std::endl;
+  std::cout << "ok " << std::hex << result << "\n";
 }
 
 auto handle_realloc(std::istringstream& argv) {
@@ -159,9 +367,9 @@ auto handle_realloc(std::istringstream& argv) {
 
   argv >> address >> size;
 
-  auto result = s21_realloc(address, size);
+  auto result = engine_realloc(address, size);
 
-  std::cout << "ok " << std::hex << result << std::endl;
+  std::cout << "ok " << std::hex << result << "\n";
 }
 
 auto handle_free(std::istringstream& argv) {
@@ -169,20 +377,290 @@ auto handle_free(std::istringstream& argv) {
 
   argv >> address;
 
-  s21_free(address);
+  engine_free(address);
 
-  std::cout << "ok " << std::hex << address << std::endl;
+  std::cout << "ok " << std::hex << address << "\n";
+}
+
+auto handle_malloc_shared(std::istringstream& argv) {
+  std::size_t size;
+
+  argv >> size;
+
+  auto result = s21_malloc_shared(size);
+
+  std::cout << "ok " << std::hex << result << "\n";
+}
+
+auto handle_retain(std::istringstream& argv) {
+  void* address;
+
+  argv >> address;
+
+  if (!s21_retain(address)) {
+    std::cout << "block is not shared\n";
+    return;
+  }
+
+  std::cout << "ok " << std::hex << address << "\n";
+}
+
+auto handle_release(std::istringstream& argv) {
+  void* address;
+
+  argv >> address;
+
+  s21_release(address);
+
+  std::cout << "ok " << std::hex << address << "\n";
+}
+
+auto handle_freeze(std::istringstream& argv) {
+  void* address;
+
+  argv >> address;
+
+  if (!s21_freeze(address)) {
+    std::cout << "block is not shared\n";
+    return;
+  }
+
+  std::cout << "ok " << std::hex << address << "\n";
+}
+
+auto print_purged(void* block, void*) {
+  std::cout << "purged " << std::hex << block << "\n";
+}
+
+auto handle_malloc_purgeable(std::istringstream& argv) {
+  std::size_t size;
+
+  argv >> size;
+
+  auto result = s21_malloc_purgeable(size, print_purged, nullptr);
+
+  std::cout << "ok " << std::hex << result << "\n";
+}
+
+auto handle_pin(std::istringstream& argv) {
+  void* address;
+
+  argv >> address;
+
+  if (!s21_pin(address)) {
+    std::cout << "block is not purgeable\n";
+    return;
+  }
+
+  std::cout << "ok " << std::hex << address << "\n";
+}
+
+auto handle_unpin(std::istringstream& argv) {
+  void* address;
+
+  argv >> address;
+
+  if (!s21_unpin(address)) {
+    std::cout << "block is not pinned\n";
+    return;
+  }
+
+  std::cout << "ok " << std::hex << address << "\n";
 }
 
 auto handle_merge_free(std::istringstream&) {
   if (!s21::memory::internal::default_allocator) {
-    std::cout << "no heap currrently allocated" << std::endl;
+    std::cout << "no heap currrently allocated\n";
     return;
   }
 
   s21::memory::internal::default_allocator->merge_free_blocks();
 
-  std::cout << "ok" << std::endl;
+  std::cout << "ok\n";
+}
+
+auto handle_trim(std::istringstream&) {
+  s21_trim();
+
+  std::cout << "ok\n";
+}
+
+auto handle_set_decay(std::istringstream& argv) {
+  std::size_t milliseconds;
+
+  argv >> milliseconds;
+
+  s21_set_decay(milliseconds);
+
+  std::cout << "ok " << std::dec << milliseconds << "\n";
+}
+
+auto handle_stats(std::istringstream&) {
+  s21_memory_stats stats;
+
+  s21_stats(&stats);
+
+  std::cout << "committed: " << std::dec << stats.committed << "\n"
+            << "resident: " << stats.resident << "\n";
+
+  for (auto& [name, lifetime] : lifetime_names) {
+    auto& lifetime_stats = stats.lifetimes[lifetime];
+
+    std::cout << name << ":\n"
+              << "\tblocks: " << lifetime_stats.blocks << "\n"
+              << "\tbytes: " << lifetime_stats.bytes << "\n"
+              << "\tspan: " << lifetime_stats.span << "\n";
+  }
+
+  std::cout << "\n";
+}
+
+auto handle_size_classes(std::istringstream&) {
+  std::size_t table[s21::memory::size_classes::max_classes];
+
+  auto count = s21_export_size_classes(table, std::size(table));
+
+  std::cout << "classes: [" << std::dec << count << "] { ";
+
+  for (auto i = 0ul; i < count; i++) {
+    std::cout << table[i] << " ";
+  }
+
+  std::cout << "}\n";
+
+  s21_size_class_stats stats;
+
+  s21_size_class_report(&stats);
+
+  std::cout << "retunes: " << stats.retunes << "\n"
+            << "requested: " << stats.requested << "\n"
+            << "before: " << stats.before << "\n"
+            << "after: " << stats.after << "\n\n";
+}
+
+auto handle_set_size_classes(std::istringstream& argv) {
+  std::vector<std::size_t> table;
+
+  for (std::size_t size; argv >> size;) {
+    table.push_back(size);
+  }
+
+  if (!s21_import_size_classes(table.data(), table.size())) {
+    std::cout << "invalid size class table\n";
+    return;
+  }
+
+  std::cout << "ok\n";
+}
+
+/**
+ * @brief Fills a heap with small blocks, frees `percent` of them at random and
+ * measures how long it takes to fill the heap again
+ */
+template <typename Engine>
+auto research(std::string_view name, std::size_t percent) {
+  constexpr auto heap_size = 1'000'000ul;
+  constexpr auto block_size = 10ul;
+
+  auto engine = Engine(heap_size);
+
+  auto blocks = std::vector<s21::memory::block_header*>();
+
+  while (auto block = engine.try_allocate_block(block_size)) {
+    blocks.push_back(block);
+  }
+
+  std::shuffle(blocks.begin(), blocks.end(), std::mt19937(21));
+
+  auto freed = blocks.size() * std::min(percent, 100ul) / 100;
+
+  for (auto i = 0ul; i < freed; i++) {
+    engine.free_block(blocks[i]);
+  }
+
+  auto refilled = 0ul;
+
+  auto start = std::chrono::steady_clock::now();
+
+  while (engine.try_allocate_block(block_size)) {
+    refilled++;
+  }
+
+  auto elapsed = std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now() - start);
+
+  std::cout << name << ":\n"
+            << "\tblocks: " << std::dec << blocks.size() << "\n"
+            << "\tfreed: " << freed << "\n"
+            << "\trefilled: " << refilled << "\n"
+            << "\ttime: " << elapsed.count() << " ms\n";
+}
+
+auto handle_research(std::istringstream& argv) {
+  std::size_t percent;
+
+  argv >> percent;
+
+  research<s21::memory::allocator>("default", percent);
+  research<s21::memory::buddy_allocator>("buddy", percent);
+
+  std::cout << "\n";
+}
+
+auto run(const std::string& command, std::istringstream& argv) -> void;
+
+auto handle_repeat(std::istringstream& argv) {
+  std::size_t count;
+  std::string command;
+  std::string arguments;
+
+  argv >> count >> command;
+
+  std::getline(argv, arguments);
+
+  auto command_argv = std::istringstream();
+
+  for (auto i = 0ul; i < count; i++) {
+    command_argv.clear();
+    command_argv.str(arguments);
+
+    run(command, command_argv);
+  }
+}
+
+auto handle_random_free(std::istringstream& argv) {
+  std::size_t percent;
+
+  argv >> percent;
+
+  auto heap_blocks = std::vector<s21::memory::block_header*>();
+
+  if (buddy_selected && buddy_heap) {
+    heap_blocks = buddy_heap->blocks();
+  } else if (!buddy_selected && s21::memory::internal::default_allocator) {
+    heap_blocks = s21::memory::internal::default_allocator->blocks();
+  } else {
+    std::cout << "no heap currently allocated\n";
+    return;
+  }
+
+  auto blocks = std::vector<void*>();
+
+  for (auto block : heap_blocks) {
+    if (block->type != s21::memory::block_type::free) {
+      blocks.push_back(s21::memory::data_of(block));
+    }
+  }
+
+  std::shuffle(blocks.begin(), blocks.end(), random_engine);
+
+  auto count = blocks.size() * std::min(percent, 100ul) / 100;
+
+  for (auto i = 0ul; i < count; i++) {
+    engine_free(blocks[i]);
+  }
+
+  std::cout << "ok " << std::dec << count << "\n";
 }
 
 auto set_value(void* address, std::string_view type, std::istringstream& argv) {
@@ -228,7 +706,7 @@ auto handle_set(std::istringstream& argv) {
   argv >> type >> mode;
 
   if (type_names.count(type) == 0) {
-    std::cout << "invalid type '" << type << "'" << std::endl;
+    std::cout << "invalid type '" << type << "'\n";
     return;
   }
 
@@ -239,7 +717,7 @@ auto handle_set(std::istringstream& argv) {
 
     header->type = type_names[type];
 
-    std::cout << "ok" << std::endl;
+    std::cout << "ok\n";
 
     return;
   }
@@ -258,64 +736,234 @@ auto handle_set(std::istringstream& argv) {
 
     header->type = type_names[type];
 
-    std::cout << "ok" << std::endl;
+    std::cout << "ok\n";
 
     return;
   }
 
-  std::cout << "invalid operation mode, use = or []" << std::endl;
+  std::cout << "invalid operation mode, use = or []\n";
+}
+
+auto dispatch(const std::string& command, std::istringstream& argv) {
+  if (buddy_selected && default_only_commands.count(command) != 0) {
+    std::cout << command << " needs the default engine\n";
+    return;
+  }
+
+  if (command == "help") {
+    handle_help(argv);
+  } else if (command == "engine") {
+    handle_engine(argv);
+  } else if (command == "set_heap") {
+    handle_set_heap(argv);
+  } else if (command == "heap") {
+    handle_heap(argv);
+  } else if (command == "block") {
+    handle_block(argv);
+  } else if (command == "block_of") {
+    handle_block_of(argv);
+  } else if (command == "malloc") {
+    handle_malloc(argv);
+  } else if (command == "malloc_hint") {
+    handle_malloc_hint(argv);
+  } else if (command == "calloc") {
+    handle_calloc(argv);
+  } else if (command == "realloc") {
+    handle_realloc(argv);
+  } else if (command == "free") {
+    handle_free(argv);
+  } else if (command == "malloc_shared") {
+    handle_malloc_shared(argv);
+  } else if (command == "retain") {
+    handle_retain(argv);
+  } else if (command == "release") {
+    handle_release(argv);
+  } else if (command == "freeze") {
+    handle_freeze(argv);
+  } else if (command == "malloc_purgeable") {
+    handle_malloc_purgeable(argv);
+  } else if (command == "pin") {
+    handle_pin(argv);
+  } else if (command == "unpin") {
+    handle_unpin(argv);
+  } else if (command == "merge_free") {
+    handle_merge_free(argv);
+  } else if (command == "trim") {
+    handle_trim(argv);
+  } else if (command == "set_decay") {
+    handle_set_decay(argv);
+  } else if (command == "stats") {
+    handle_stats(argv);
+  } else if (command == "size_classes") {
+    handle_size_classes(argv);
+  } else if (command == "set_size_classes") {
+    handle_set_size_classes(argv);
+  } else if (command == "repeat") {
+    handle_repeat(argv);
+  } else if (command == "random_free") {
+    handle_random_free(argv);
+  } else if (command == "research") {
+    handle_research(argv);
+  } else if (command == "set") {
+    handle_set(argv);
+  } else {
+    std::cout << "unknown command: " << command << "\n";
+  }
+}
+
+/**
+ * @brief Dispatches the command, recording its latency in batch mode
+ */
+auto run(const std::string& command, std::istringstream& argv) -> void {
+  // Commands run by repeat are accounted on their own
+  if (!record_latencies || command == "repeat") {
+    dispatch(command, argv);
+
+    return;
+  }
+
+  auto start = std::chrono::steady_clock::now();
+
+  dispatch(command, argv);
+
+  command_latencies[command].push_back(std::chrono::steady_clock::now() -
+                                       start);
+}
+
+/**
+ * @brief Runs the line, reusing the stream of the caller to tokenize it
+ * @return false if the line asks to exit
+ */
+auto execute(const std::string& line, std::istringstream& argv) -> bool {
+  argv.clear();
+  argv.str(line);
+
+  std::string command;
+
+  argv >> command;
+
+  if (command.empty() || command.front() == '#') {
+    return true;
+  }
+
+  if (command == "exit") {
+    std::cout << "goodbye\n";
+    return false;
+  }
+
+  run(command, argv);
+
+  return true;
+}
+
+auto percentile(const std::vector<std::chrono::nanoseconds>& sorted,
+                double rank) {
+  auto index = static_cast<std::size_t>(rank * (sorted.size() - 1));
+
+  return sorted[index].count();
+}
+
+auto print_summary(std::chrono::nanoseconds total) {
+  auto seconds = std::chrono::duration<double>(total).count();
+  auto count = 0ul;
+
+  for (auto& [command, latencies] : command_latencies) {
+    count += latencies.size();
+  }
+
+  std::cout << "summary:\n"
+            << "\tcommands: " << std::dec << count << "\n"
+            << "\ttime: " << seconds * 1000 << " ms\n"
+            << "\tops/sec: " << count / seconds << "\n";
+
+  for (auto& [command, latencies] : command_latencies) {
+    std::sort(latencies.begin(), latencies.end());
+
+    auto busy = std::chrono::nanoseconds(0);
+
+    for (auto latency : latencies) {
+      busy += latency;
+    }
+
+    std::cout << command << ":\n"
+              << "\tcount: " << latencies.size() << "\n"
+              << "\tops/sec: "
+              << latencies.size() / std::chrono::duration<double>(busy).count()
+              << "\n"
+              << "\tp50: " << percentile(latencies, 0.5) << " ns\n"
+              << "\tp90: " << percentile(latencies, 0.9) << " ns\n"
+              << "\tp99: " << percentile(latencies, 0.99) << " ns\n"
+              << "\tmax: " << latencies.back().count() << " ns\n";
+  }
 }
 
 auto cli() -> void {
-  std::cout << "s21_memory repl :: use 'help' for more info\n" << std::endl;
+  std::cout << "s21_memory repl :: use 'help' for more info\n\n";
+
+  auto argv = std::istringstream();
 
   while (true) {
-    std::cout << "$ ";
+    std::cout << "$ " << std::flush;
 
     std::string line;
 
-    std::getline(std::cin, line);
+    if (!std::getline(std::cin, line)) {
+      std::cout << "\n";
+      return;
+    }
 
-    std::istringstream argv(line);
+    if (!execute(line, argv)) {
+      return;
+    }
 
-    std::string command;
+    std::cout << std::flush;
+  }
+}
 
-    argv >> command;
+/**
+ * @brief Runs commands from the input without a prompt, buffering the output,
+ * and prints the latency summary at the end
+ */
+auto batch(std::istream& input) -> void {
+  record_latencies = true;
 
-    if (command == "exit") {
-      std::cout << "goodbye" << std::endl;
-      return;
-    }
+  auto argv = std::istringstream();
+  auto start = std::chrono::steady_clock::now();
 
-    if (command == "help") {
-      handle_help(argv);
-    } else if (command == "set_heap") {
-      handle_set_heap(argv);
-    } else if (command == "heap") {
-      handle_heap(argv);
-    } else if (command == "block") {
-      handle_block(argv);
-    } else if (command == "malloc") {
-      handle_malloc(argv);
-    } else if (command == "calloc") {
-      handle_calloc(argv);
-    } else if (command == "realloc") {
-      handle_realloc(argv);
-    } else if (command == "free") {
-      handle_free(argv);
-    } else if (command == "merge_free") {
-      handle_merge_free(argv);
-    } else if (command == "set") {
-      handle_set(argv);
-    } else {
-      std::cout << "unknown command: " << command << std::endl;
+  for (std::string line; std::getline(input, line);) {
+    if (!execute(line, argv)) {
+      break;
     }
   }
+
+  print_summary(std::chrono::steady_clock::now() - start);
 }
 
-auto main() -> int {
+auto main(int argc, char** argv) -> int {
+  auto arguments = std::vector<std::string_view>(argv + 1, argv + argc);
+
   try {
-    cli();
+    if (arguments.empty()) {
+      cli();
+    } else if (arguments[0] == "--batch" && arguments.size() <= 2) {
+      std::ios::sync_with_stdio(false);
+
+      if (arguments.size() == 1) {
+        batch(std::cin);
+      } else {
+        auto input = std::ifstream(std::string(arguments[1]));
+
+        if (!input) {
+          std::cerr << "can't open " << arguments[1] << std::endl;
+          return 1;
+        }
+
+        batch(input);
+      }
+    } else {
+      std::cerr << "usage: " << argv[0] << " [--batch [file]]" << std::endl;
+      return 1;
+    }
   } catch (std::exception& e) {
     std::cout << "Fatal error: " << e.what() << std::endl;
     return 1;
@@ -2,17 +2,175 @@
 
 #include <stddef.h>
 
+#ifdef __cplusplus
+#define S21_NOEXCEPT noexcept
+#else
+#define S21_NOEXCEPT
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-void* s21_malloc(size_t size);
+/* Expected lifetime of an allocation, see s21_malloc_hint */
+enum s21_lifetime {
+  S21_LIFETIME_SHORT,
+  S21_LIFETIME_LONG,
+  S21_LIFETIME_PERMANENT,
+  S21_LIFETIME_COUNT
+};
+
+/* Called after a purgeable block was reclaimed, see s21_malloc_purgeable */
+typedef void (*s21_purge_callback)(void* block, void* context);
+
+struct s21_lifetime_stats {
+  /* Number of allocated blocks */
+  size_t blocks;
+  /* Allocated bytes, including block headers */
+  size_t bytes;
+  /* Distance from the lowest to the end of the highest allocated block */
+  size_t span;
+};
+
+struct s21_size_class_stats {
+  /* Number of times the table was re-derived */
+  size_t retunes;
+  /* Bytes requested by the allocations seen before the last retune */
+  size_t requested;
+  /* Bytes the same allocations take with the previous and the current table */
+  size_t before;
+  size_t after;
+};
+
+struct s21_memory_stats {
+  /* Bytes reserved for the heap */
+  size_t committed;
+  /* Bytes of the heap which are not returned to the OS */
+  size_t resident;
+  /* Placement of blocks of each lifetime, indexed by s21_lifetime */
+  struct s21_lifetime_stats lifetimes[S21_LIFETIME_COUNT];
+};
+
+void* s21_malloc(size_t size) S21_NOEXCEPT;
+
+/**
+ * Allocates a block in the heap region of its lifetime class: short-lived
+ * blocks are placed from the start of the heap, long-lived and permanent ones
+ * from its end, so they don't pin holes between transient blocks.
+ * Long-lived and permanent blocks share the upper region in allocation order:
+ * a heap has only two ends, and a separate permanent arena would need a size
+ * fixed in advance. Holes of freed long-lived blocks are reused by later
+ * blocks of either class. s21_stats still reports the classes separately.
+ */
+void* s21_malloc_hint(size_t size, enum s21_lifetime lifetime) S21_NOEXCEPT;
+
+void* s21_calloc(size_t n, size_t size) S21_NOEXCEPT;
+
+void* s21_realloc(void* block, size_t size) S21_NOEXCEPT;
+
+void s21_free(void* block) S21_NOEXCEPT;
+
+/**
+ * Allocates a reference-counted block holding one reference. The block is
+ * returned to the heap when the last reference is released, so it can be
+ * handed over to another stage without copying. s21_free on a shared block
+ * releases one reference, s21_realloc fails unless the size is 0.
+ */
+void* s21_malloc_shared(size_t size) S21_NOEXCEPT;
+
+/**
+ * Adds a reference to a shared block, the caller has to hold one already.
+ * Returns the block, or NULL if it isn't shared.
+ */
+void* s21_retain(void* block) S21_NOEXCEPT;
+
+/**
+ * Drops a reference to a shared block, frees it if it was the last one.
+ * Does nothing if the block isn't shared. May be called on any thread: if
+ * the last reference is dropped on a thread other than the one which created
+ * the heap, the block is freed by the next s21_malloc, s21_realloc, s21_free
+ * or s21_trim call of the heap's thread, and stays allocated until then.
+ */
+void s21_release(void* block) S21_NOEXCEPT;
+
+/**
+ * Marks a shared block read-only. Writes made before freezing are visible to
+ * any thread which observes the block as frozen through s21_is_frozen.
+ * Returns non-zero on success, or zero if the block isn't shared.
+ */
+int s21_freeze(void* block) S21_NOEXCEPT;
+
+int s21_is_frozen(const void* block) S21_NOEXCEPT;
+
+/**
+ * Allocates a block the allocator may reclaim instead of failing a later
+ * allocation, e.g. for a cache entry. The block is returned pinned, so it can
+ * be filled; once unpinned it can be reclaimed at any allocation, least
+ * recently unpinned blocks first. `callback`, which may be NULL, is then called
+ * with the block and `context`; the block must not be accessed from that point
+ * and the callback may allocate. s21_free works as usual, s21_realloc fails
+ * unless the size is 0.
+ */
+void* s21_malloc_purgeable(size_t size, s21_purge_callback callback,
+                           void* context) S21_NOEXCEPT;
+
+/**
+ * Pins a purgeable block so it isn't reclaimed while it's used, pins nest.
+ * Returns zero if the block was reclaimed, in which case its owner has to
+ * rebuild it. Without a callback a reclaimed block can't be told from a new
+ * purgeable block at the same address.
+ */
+int s21_pin(void* block) S21_NOEXCEPT;
+
+/**
+ * Drops a pin, the block becomes reclaimable when the last one is dropped.
+ * Returns zero if the block isn't pinned or was reclaimed.
+ */
+int s21_unpin(void* block) S21_NOEXCEPT;
+
+/**
+ * Grows the block in place without moving it.
+ * Returns non-zero on success, on failure the block is left untouched.
+ */
+int s21_try_expand(void* block, size_t size) S21_NOEXCEPT;
+
+/**
+ * Returns all whole free pages of the heap to the OS.
+ */
+void s21_trim(void) S21_NOEXCEPT;
+
+/**
+ * Sets how long free pages stay resident before they are returned to the OS.
+ */
+void s21_set_decay(size_t milliseconds) S21_NOEXCEPT;
+
+void s21_stats(struct s21_memory_stats* stats) S21_NOEXCEPT;
+
+/**
+ * Copies up to `capacity` entries of the size class table into `table`.
+ * s21_malloc doesn't split off free remainders smaller than the smallest
+ * class. Returns the number of entries in the table.
+ */
+size_t s21_export_size_classes(size_t* table, size_t capacity) S21_NOEXCEPT;
 
-void* s21_calloc(size_t n, size_t size);
+/**
+ * Replaces the size class table, e.g. with one exported by a previous run.
+ * Entries have to be strictly increasing and word-aligned.
+ * Returns non-zero on success, on failure the table is left untouched.
+ */
+int s21_import_size_classes(const size_t* table, size_t count) S21_NOEXCEPT;
 
-void* s21_realloc(void* block, size_t size);
+/**
+ * Reports how much memory the last retune of the size class table saves.
+ */
+void s21_size_class_report(struct s21_size_class_stats* stats) S21_NOEXCEPT;
 
-void s21_free(void* block);
+/**
+ * Returns the start of the allocated block containing `pointer`, which may
+ * point anywhere into the block, or NULL if there is none. Constant-time when
+ * built with S21_MEMORY_OUT_OF_BAND_METADATA.
+ */
+void* s21_block_of(const void* pointer) S21_NOEXCEPT;
 
 #ifdef __cplusplus
 }
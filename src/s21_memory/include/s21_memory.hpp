@@ -1,8 +1,12 @@
 #pragma once
 
+#include <chrono>
 #include <optional>
+#include <vector>
 
 #include "s21_memory/allocator.hpp"
+#include "s21_memory/purgeable.hpp"
+#include "s21_memory/size_classes.hpp"
 
 namespace s21 {
 
@@ -10,6 +14,12 @@ namespace memory::internal {
 
 extern std::optional<memory::allocator> default_allocator;
 
+extern std::chrono::milliseconds default_decay;
+
+extern memory::size_classes default_size_classes;
+
+extern memory::purgeable_blocks default_purgeable;
+
 }  // namespace memory::internal
 
 /**
@@ -19,9 +29,85 @@ extern std::optional<memory::allocator> default_allocator;
  */
 auto set_heap(std::size_t size) -> void;
 
-auto malloc(std::size_t size) -> void*;
-auto calloc(std::size_t n, std::size_t size) -> void*;
-auto realloc(void* block, std::size_t size) -> void*;
-auto free(void* block) -> void;
+auto malloc(std::size_t size) noexcept -> void*;
+auto malloc_hint(std::size_t size, memory::block_lifetime lifetime) noexcept
+    -> void*;
+auto calloc(std::size_t n, std::size_t size) noexcept -> void*;
+auto realloc(void* block, std::size_t size) noexcept -> void*;
+auto free(void* block) noexcept -> void;
+
+/**
+ * @brief Allocates a block holding one reference, see s21_malloc_shared
+ */
+auto malloc_shared(std::size_t size) noexcept -> void*;
+
+/**
+ * @return The block, or nullptr if it isn't shared
+ */
+auto retain(void* block) noexcept -> void*;
+auto release(void* block) noexcept -> void;
+
+/**
+ * @brief Marks a shared block read-only
+ * @return false if the block isn't shared
+ */
+auto freeze(void* block) noexcept -> bool;
+auto is_frozen(const void* block) noexcept -> bool;
+
+/**
+ * @brief Allocates a pinned block which may be reclaimed once unpinned, see
+ * s21_malloc_purgeable
+ */
+auto malloc_purgeable(std::size_t size,
+                      memory::purge_callback callback = nullptr,
+                      void* context = nullptr) noexcept -> void*;
+
+/**
+ * @return false if the block was reclaimed
+ */
+auto pin(void* block) noexcept -> bool;
+auto unpin(void* block) noexcept -> bool;
+
+/**
+ * @brief Grows the block in place, never moves it
+ * @return true if the block can now hold `size` bytes
+ */
+auto try_expand(void* block, std::size_t size) noexcept -> bool;
+
+/**
+ * @brief Returns all whole free pages of the heap to the OS
+ */
+auto trim() noexcept -> void;
+
+/**
+ * @brief Sets how long free pages stay resident before they are purged, the
+ * setting is kept across set_heap calls
+ */
+auto set_decay(std::chrono::milliseconds decay) noexcept -> void;
+
+auto stats() noexcept -> memory::allocator_stats;
+
+/**
+ * @return Size classes learned by malloc, free remainders smaller than the
+ * smallest class are not split off blocks
+ */
+auto size_classes() -> std::vector<std::size_t>;
+
+/**
+ * @brief Replaces the size class table, the setting is kept across set_heap
+ * calls and the table keeps adapting to the workload afterwards
+ * @return false if the table is invalid, see memory::size_classes::set_table
+ */
+auto set_size_classes(const std::vector<std::size_t>& table) -> bool;
+
+/**
+ * @brief Reports the efficiency of the last size class retune
+ */
+auto size_class_stats() noexcept -> memory::size_class_stats;
+
+/**
+ * @return Start of the allocated block containing `pointer` or nullptr
+ */
+auto block_of(const void* pointer) noexcept -> void*;
 
 }  // namespace s21
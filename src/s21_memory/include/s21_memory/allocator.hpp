@@ -1,41 +1,727 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <cstddef>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <system_error>
+#include <type_traits>
 #include <vector>
 
+#include "s21_memory/bitmap_fit.hpp"
 #include "s21_memory/block.hpp"
+#include "s21_memory/fit_policy.hpp"
 #include "s21_memory/heap.hpp"
+#include "s21_memory/lock_policy.hpp"
+#include "s21_memory/probe.hpp"
+#include "s21_memory/purge_policy.hpp"
+#include "s21_memory/static_heap.hpp"
 
 namespace s21::memory {
 
-class allocator {
+#ifdef S21_MEMORY_OUT_OF_BAND_METADATA
+using default_fit = bitmap_fit;
+#else
+using default_fit = first_fit;
+#endif
+
+struct lifetime_stats {
+  /// Number of allocated blocks
+  std::size_t blocks;
+  /// Allocated bytes, including block headers
+  std::size_t bytes;
+  /// Distance from the lowest to the end of the highest allocated block
+  std::size_t span;
+};
+
+struct allocator_stats {
+  /// Bytes reserved for the heap
+  std::size_t committed;
+  /// Bytes of the heap which are not returned to the OS
+  std::size_t resident;
+  /// Placement of blocks of each lifetime class, indexed by block_lifetime
+  std::array<lifetime_stats, lifetime_count> lifetimes;
+};
+
+/**
+ * @brief Heap allocator configured with compile-time policies
+ * @tparam FitPolicy Free block search strategy, see fit_policy.hpp and
+ * bitmap_fit.hpp
+ * @tparam LockPolicy BasicLockable guarding public operations, see
+ * lock_policy.hpp
+ * @tparam PurgePolicy Strategy of returning free pages to the OS, see
+ * purge_policy.hpp
+ * @tparam Heap Backing store, either dynamic heap or static_heap
+ */
+template <typename FitPolicy = default_fit, typename LockPolicy = null_lock,
+          typename PurgePolicy = decay_purge, typename Heap = heap>
+class basic_allocator {
  public:
-  allocator(std::size_t heap_size);
+  using fit_policy = FitPolicy;
+  using lock_policy = LockPolicy;
+  using purge_policy = PurgePolicy;
+  using heap_type = Heap;
+
+  basic_allocator(std::size_t heap_size);
 
-  auto allocate_block(std::size_t size, block_type type = block_type::char_t)
+  /**
+   * @brief Constant-initializes an allocator over a static_heap
+   * @note Purge policy is not attached, static heaps are never purged
+   */
+  template <typename H = Heap, typename = std::enable_if_t<H::is_static>>
+  constexpr basic_allocator()
+      : heap_(), root_(heap_.root()), tail_(heap_.root()) {}
+
+  /**
+   * @brief Allocates a block, short-lived blocks are placed from the start of
+   * the heap and long-lived and permanent ones from its end
+   * @throws std::bad_alloc if there is no free block large enough
+   */
+  auto allocate_block(
+      std::size_t size, block_type type = block_type::char_t,
+      block_lifetime lifetime = block_lifetime::short_lived) -> block_header*;
+
+  /**
+   * @return Allocated block or nullptr if there is no free block large enough
+   */
+  auto try_allocate_block(
+      std::size_t size, block_type type = block_type::char_t,
+      block_lifetime lifetime = block_lifetime::short_lived) noexcept
       -> block_header*;
 
+  /**
+   * @throws std::bad_alloc if the block can't be grown, the block stays valid
+   */
   auto reallocate_block(block_header* block, std::size_t size) -> block_header*;
 
+  /**
+   * @return Reallocated block, or nullptr if the block was freed because
+   * `size` is 0 or if it can't be grown, in which case it stays valid
+   */
+  auto try_reallocate_block(block_header* block, std::size_t size) noexcept
+      -> block_header*;
+
+  /**
+   * @brief Grows the block in place, never moves it
+   * @return true if the block is at least `size` bytes large afterwards
+   */
+  auto try_expand_block(block_header* block, std::size_t size) noexcept
+      -> bool;
+
   auto free_block(block_header* block) -> void;
 
   auto merge_free_blocks() -> void;
 
+  /**
+   * @return Allocated block containing `address`, which may point anywhere
+   * into the block, or nullptr if there is none
+   */
+  auto block_of(const void* address) const -> block_header*;
+
+  /**
+   * @brief Returns all whole free pages to the OS immediately
+   */
+  auto trim() -> void;
+
+  auto purger() -> PurgePolicy&;
+
+  /**
+   * @brief Sets the largest remainder, in bytes of data, which is left in an
+   * allocated block instead of being split off as a free block
+   */
+  auto set_split_threshold(std::size_t threshold) -> void;
+
+  auto stats() const -> allocator_stats;
+
   auto size() const -> std::size_t;
 
   auto blocks() const -> std::vector<block_header*>;
 
  private:
+  using lock_guard = std::lock_guard<LockPolicy>;
+
+  /**
+   * @brief Locks the allocator inside noexcept operations
+   * @return Lock which doesn't own the allocator if locking failed, e.g.
+   * because std::mutex reported a system error
+   */
+  auto try_lock() noexcept -> std::unique_lock<LockPolicy>;
+
+  auto allocate_unlocked(std::size_t size, block_type type,
+                         block_lifetime lifetime) -> block_header*;
+
+  auto find_from_top(std::size_t size, std::size_t& length) -> block_header*;
+
+  auto free_unlocked(block_header* block) -> void;
+
+  auto merge_unlocked() -> void;
+
+  auto merge_with_next(block_header* block) -> void;
+
+  auto commit(block_header* block) -> void;
+
+  auto decay() -> void;
+
+  auto should_split(const block_header* block, std::size_t size) const -> bool;
+
   auto split_block(block_header* block, std::size_t size) -> block_header*;
 
   auto shrink_block(block_header* block, std::size_t size) -> block_header*;
 
   auto expand_block(block_header* block, std::size_t size) -> block_header*;
 
+  auto grow_forward(block_header* block, std::size_t size) -> bool;
+
+  auto grow_backward(block_header* block, std::size_t size) -> block_header*;
+
  private:
-  heap heap_;
+  Heap heap_;
 
   block_header* root_;
+  block_header* tail_;
+
+  FitPolicy fit_;
+
+  PurgePolicy purge_;
+
+  std::size_t split_threshold_ = 0;
+
+  mutable LockPolicy lock_;
 };
 
+using allocator = basic_allocator<>;
+
+/**
+ * @brief Allocator over inline storage of N bytes, usable as a global with no
+ * dynamic initialization
+ */
+template <std::size_t N, typename FitPolicy = first_fit,
+          typename LockPolicy = null_lock>
+using static_allocator =
+    basic_allocator<FitPolicy, LockPolicy, no_purge, static_heap<N>>;
+
+extern template class basic_allocator<>;
+
+template <typename Fit, typename Lock, typename Purge, typename Heap>
+basic_allocator<Fit, Lock, Purge, Heap>::basic_allocator(std::size_t heap_size)
+    : heap_(block_size_of(heap_size)),
+      root_(new (heap_.data()) block_header(block_type::free, heap_size)),
+      tail_(root_) {
+  fit_.attach(heap_.data(), heap_.size());
+  purge_.attach(heap_.data(), heap_.size());
+}
+
+template <typename Fit, typename Lock, typename Purge, typename Heap>
+auto basic_allocator<Fit, Lock, Purge, Heap>::merge_free_blocks() -> void {
+  auto guard = lock_guard(lock_);
+
+  merge_unlocked();
+}
+
+template <typename Fit, typename Lock, typename Purge, typename Heap>
+auto basic_allocator<Fit, Lock, Purge, Heap>::block_of(
+    const void* address) const -> block_header* {
+  auto guard = lock_guard(lock_);
+
+  return fit_.block_of(root_, address);
+}
+
+template <typename Fit, typename Lock, typename Purge, typename Heap>
+auto basic_allocator<Fit, Lock, Purge, Heap>::merge_unlocked() -> void {
+  auto current = root_;
+
+  while (current->next) {
+    if (current->type != block_type::free ||
+        current->next->type != block_type::free) {
+      current = current->next;
+
+      continue;
+    }
+
+    merge_with_next(current);
+  }
+}
+
+template <typename Fit, typename Lock, typename Purge, typename Heap>
+auto basic_allocator<Fit, Lock, Purge, Heap>::merge_with_next(
+    block_header* block) -> void {
+  auto next = block->next;
+
+  block->size += block_size_of(next->size);
+  block->next = next->next;
+
+  if (block->next) {
+    block->next->prev = block;
+  } else {
+    tail_ = block;
+  }
+
+  fit_.on_merge(block, next);
+
+  S21_PROBE2(merge, block, block->size);
+}
+
+template <typename Fit, typename Lock, typename Purge, typename Heap>
+auto basic_allocator<Fit, Lock, Purge, Heap>::commit(block_header* block)
+    -> void {
+  fit_.on_use(block);
+
+  purge_.on_commit(reinterpret_cast<raw_ptr>(block),
+                   data_of(block) + block->size);
+}
+
+template <typename Fit, typename Lock, typename Purge, typename Heap>
+auto basic_allocator<Fit, Lock, Purge, Heap>::decay() -> void {
+  if (!purge_.should_tick()) {
+    return;
+  }
+
+  merge_unlocked();
+
+  purge_.tick(root_, false);
+}
+
+template <typename Fit, typename Lock, typename Purge, typename Heap>
+auto basic_allocator<Fit, Lock, Purge, Heap>::trim() -> void {
+  auto guard = lock_guard(lock_);
+
+  merge_unlocked();
+
+  purge_.tick(root_, true);
+}
+
+template <typename Fit, typename Lock, typename Purge, typename Heap>
+auto basic_allocator<Fit, Lock, Purge, Heap>::purger() -> Purge& {
+  return purge_;
+}
+
+template <typename Fit, typename Lock, typename Purge, typename Heap>
+auto basic_allocator<Fit, Lock, Purge, Heap>::set_split_threshold(
+    std::size_t threshold) -> void {
+  auto guard = lock_guard(lock_);
+
+  split_threshold_ = align_of(threshold);
+}
+
+template <typename Fit, typename Lock, typename Purge, typename Heap>
+auto basic_allocator<Fit, Lock, Purge, Heap>::stats() const -> allocator_stats {
+  auto guard = lock_guard(lock_);
+
+  auto result = allocator_stats();
+
+  result.committed = heap_.size();
+  result.resident = heap_.size() - purge_.purged();
+
+  auto begin = std::array<raw_ptr, lifetime_count>();
+  auto end = std::array<raw_ptr, lifetime_count>();
+
+  for (auto block = root_; block; block = block->next) {
+    if (block->type == block_type::free) {
+      continue;
+    }
+
+    auto index = static_cast<std::size_t>(block->lifetime);
+    auto& lifetime = result.lifetimes[index];
+
+    lifetime.blocks++;
+    lifetime.bytes += block_size_of(block->size);
+
+    if (!begin[index]) {
+      begin[index] = reinterpret_cast<raw_ptr>(block);
+    }
+
+    end[index] = data_of(block) + block->size;
+  }
+
+  for (auto i = 0; i < lifetime_count; i++) {
+    result.lifetimes[i].span = static_cast<std::size_t>(end[i] - begin[i]);
+  }
+
+  return result;
+}
+
+template <typename Fit, typename Lock, typename Purge, typename Heap>
+auto basic_allocator<Fit, Lock, Purge, Heap>::should_split(
+    const block_header* block, std::size_t size) const -> bool {
+  return block->size > block_size_of(size) + split_threshold_;
+}
+
+template <typename Fit, typename Lock, typename Purge, typename Heap>
+auto basic_allocator<Fit, Lock, Purge, Heap>::split_block(
+    block_header* block, std::size_t size) -> block_header* {
+  auto address = data_of(block) + size;
+
+  purge_.on_commit(address, address + sizeof(block_header));
+
+  auto next_block = new (address)
+      block_header(block_type::free, block->size - block_size_of(size));
+
+  next_block->next = block->next;
+  next_block->prev = block;
+
+  if (next_block->next) {
+    next_block->next->prev = next_block;
+  } else {
+    tail_ = next_block;
+  }
+
+  block->size = size;
+  block->next = next_block;
+
+  fit_.on_split(block, next_block);
+
+  S21_PROBE3(split, block, size, next_block->size);
+
+  return next_block;
+}
+
+template <typename Fit, typename Lock, typename Purge, typename Heap>
+auto basic_allocator<Fit, Lock, Purge, Heap>::allocate_block(
+    std::size_t size, block_type type, block_lifetime lifetime)
+    -> block_header* {
+  auto block = try_allocate_block(size, type, lifetime);
+
+  if (!block) {
+    throw std::bad_alloc();
+  }
+
+  return block;
+}
+
+template <typename Fit, typename Lock, typename Purge, typename Heap>
+auto basic_allocator<Fit, Lock, Purge, Heap>::try_lock() noexcept
+    -> std::unique_lock<Lock> {
+  auto guard = std::unique_lock<Lock>(lock_, std::defer_lock);
+
+  try {
+    guard.lock();
+  } catch (std::system_error&) {
+  }
+
+  return guard;
+}
+
+template <typename Fit, typename Lock, typename Purge, typename Heap>
+auto basic_allocator<Fit, Lock, Purge, Heap>::try_allocate_block(
+    std::size_t size, block_type type, block_lifetime lifetime) noexcept
+    -> block_header* {
+  auto guard = try_lock();
+
+  if (!guard) {
+    return nullptr;
+  }
+
+  decay();
+
+  return allocate_unlocked(size, type, lifetime);
+}
+
+template <typename Fit, typename Lock, typename Purge, typename Heap>
+auto basic_allocator<Fit, Lock, Purge, Heap>::find_from_top(
+    std::size_t size, std::size_t& length) -> block_header* {
+  length = 0;
+
+  for (auto block = tail_; block; block = block->prev) {
+    length++;
+
+    if (is_fit(block, size)) {
+      return block;
+    }
+  }
+
+  return nullptr;
+}
+
+template <typename Fit, typename Lock, typename Purge, typename Heap>
+auto basic_allocator<Fit, Lock, Purge, Heap>::allocate_unlocked(
+    std::size_t size, block_type type, block_lifetime lifetime)
+    -> block_header* {
+  auto from_top = lifetime != block_lifetime::short_lived;
+
+  if (from_top || Fit::requires_merge) {
+    merge_unlocked();
+  }
+
+  auto aligned_size = align_of(size);
+
+  auto length = std::size_t(0);
+
+  auto block = from_top ? find_from_top(aligned_size, length)
+                        : fit_.find(root_, aligned_size, length);
+
+  if (!block) {
+    S21_PROBE2(out_of_memory, aligned_size, length);
+
+    return nullptr;
+  }
+
+  while (block->size < aligned_size) {
+    merge_with_next(block);
+  }
+
+  if (should_split(block, aligned_size)) {
+    if (from_top) {
+      block = split_block(block, block->size - block_size_of(aligned_size));
+    } else {
+      split_block(block, aligned_size);
+    }
+  }
+
+  commit(block);
+
+  block->type = type;
+  block->lifetime = lifetime;
+
+  S21_PROBE3(allocate, block, aligned_size, length);
+
+  return block;
+}
+
+template <typename Fit, typename Lock, typename Purge, typename Heap>
+auto basic_allocator<Fit, Lock, Purge, Heap>::shrink_block(
+    block_header* block, std::size_t size) -> block_header* {
+  auto size_difference = block->size - size;
+
+  if (size_difference < block_size_of(0)) {
+    return block;
+  }
+
+  auto next_block = split_block(block, size);
+
+  free_unlocked(next_block);
+
+  return block;
+}
+
+template <typename Fit, typename Lock, typename Purge, typename Heap>
+auto basic_allocator<Fit, Lock, Purge, Heap>::grow_forward(
+    block_header* block, std::size_t size) -> bool {
+  auto available = block->size;
+
+  for (auto next = block->next;
+       next && next->type == block_type::free && available < size;
+       next = next->next) {
+    available += block_size_of(next->size);
+  }
+
+  if (available < size) {
+    return false;
+  }
+
+  while (block->size < size) {
+    merge_with_next(block);
+  }
+
+  if (should_split(block, size)) {
+    split_block(block, size);
+  }
+
+  commit(block);
+
+  return true;
+}
+
+template <typename Fit, typename Lock, typename Purge, typename Heap>
+auto basic_allocator<Fit, Lock, Purge, Heap>::grow_backward(
+    block_header* block, std::size_t size) -> block_header* {
+  auto available = block->size;
+
+  for (auto next = block->next; next && next->type == block_type::free;
+       next = next->next) {
+    available += block_size_of(next->size);
+  }
+
+  auto start = block;
+
+  while (start->prev && start->prev->type == block_type::free &&
+         available < size) {
+    start = start->prev;
+    available += block_size_of(start->size);
+  }
+
+  if (start == block || available < size) {
+    return nullptr;
+  }
+
+  auto type = block->type;
+  auto lifetime = block->lifetime;
+  auto data_size = block->size;
+  auto data = data_of(block);
+  auto end = block->next;
+
+  while (start->next != end) {
+    merge_with_next(start);
+  }
+
+  while (start->size < size) {
+    merge_with_next(start);
+  }
+
+  fit_.on_release(start);
+
+  std::memmove(data_of(start), data, data_size);
+
+  start->type = type;
+  start->lifetime = lifetime;
+
+  if (should_split(start, size)) {
+    split_block(start, size);
+  }
+
+  commit(start);
+
+  return start;
+}
+
+template <typename Fit, typename Lock, typename Purge, typename Heap>
+auto basic_allocator<Fit, Lock, Purge, Heap>::expand_block(
+    block_header* block, std::size_t size) -> block_header* {
+  if (grow_forward(block, size)) {
+    S21_PROBE3(realloc_in_place, block, block, size);
+
+    return block;
+  }
+
+  if (auto result = grow_backward(block, size)) {
+    S21_PROBE3(realloc_in_place, block, result, size);
+
+    return result;
+  }
+
+  auto next_block = allocate_unlocked(size, block->type, block->lifetime);
+
+  if (!next_block) {
+    return nullptr;
+  }
+
+  std::memcpy(data_of(next_block), data_of(block), block->size);
+
+  S21_PROBE3(realloc_move, block, next_block, size);
+
+  free_unlocked(block);
+
+  return next_block;
+}
+
+template <typename Fit, typename Lock, typename Purge, typename Heap>
+auto basic_allocator<Fit, Lock, Purge, Heap>::try_expand_block(
+    block_header* block, std::size_t size) noexcept -> bool {
+  if (!block) {
+    return false;
+  }
+
+  auto guard = try_lock();
+
+  if (!guard) {
+    return false;
+  }
+
+  auto aligned_size = align_of(size);
+
+  if (aligned_size <= block->size) {
+    return true;
+  }
+
+  if (!grow_forward(block, aligned_size)) {
+    return false;
+  }
+
+  S21_PROBE3(realloc_in_place, block, block, aligned_size);
+
+  return true;
+}
+
+template <typename Fit, typename Lock, typename Purge, typename Heap>
+auto basic_allocator<Fit, Lock, Purge, Heap>::reallocate_block(
+    block_header* block, std::size_t size) -> block_header* {
+  auto result = try_reallocate_block(block, size);
+
+  if (!result && block && size != 0) {
+    throw std::bad_alloc();
+  }
+
+  return result;
+}
+
+template <typename Fit, typename Lock, typename Purge, typename Heap>
+auto basic_allocator<Fit, Lock, Purge, Heap>::try_reallocate_block(
+    block_header* block, std::size_t size) noexcept -> block_header* {
+  if (!block) {
+    return nullptr;
+  }
+
+  auto guard = try_lock();
+
+  if (!guard) {
+    return nullptr;
+  }
+
+  decay();
+
+  if (size == 0) {
+    free_unlocked(block);
+
+    return nullptr;
+  }
+
+  auto aligned_size = align_of(size);
+
+  if (aligned_size < block->size) {
+    return shrink_block(block, aligned_size);
+  }
+
+  if (aligned_size > block->size) {
+    return expand_block(block, aligned_size);
+  }
+
+  return block;
+}
+
+template <typename Fit, typename Lock, typename Purge, typename Heap>
+auto basic_allocator<Fit, Lock, Purge, Heap>::free_block(block_header* block)
+    -> void {
+  if (!block) {
+    return;
+  }
+
+  auto guard = lock_guard(lock_);
+
+  free_unlocked(block);
+  decay();
+}
+
+template <typename Fit, typename Lock, typename Purge, typename Heap>
+auto basic_allocator<Fit, Lock, Purge, Heap>::free_unlocked(block_header* block)
+    -> void {
+  block->type = block_type::free;
+  block->frozen.store(false, std::memory_order_relaxed);
+  block->purgeable = false;
+  block->references.store(0, std::memory_order_relaxed);
+
+  fit_.on_release(block);
+
+  S21_PROBE2(free, block, block->size);
+}
+
+template <typename Fit, typename Lock, typename Purge, typename Heap>
+auto basic_allocator<Fit, Lock, Purge, Heap>::size() const -> std::size_t {
+  return heap_.size();
+}
+
+template <typename Fit, typename Lock, typename Purge, typename Heap>
+auto basic_allocator<Fit, Lock, Purge, Heap>::blocks() const
+    -> std::vector<block_header*> {
+  auto guard = lock_guard(lock_);
+
+  auto result = std::vector<block_header*>();
+
+  for (auto block = root_; block; block = block->next) {
+    result.push_back(block);
+  }
+
+  return result;
+}
+
 }  // namespace s21::memory
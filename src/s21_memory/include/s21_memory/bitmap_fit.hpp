@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "s21_memory/block.hpp"
+
+namespace s21::memory {
+
+/**
+ * @brief First fit over out-of-band metadata
+ *
+ * Every heap word has a bit in the `used` bitmap, which is set while the word
+ * belongs to an allocated block (header included), and a bit in the `starts`
+ * bitmap, which is set if a block header starts at the word. Free runs are
+ * found by scanning the inverted `used` bitmap 64 words at a time with
+ * count-trailing-zeros, so neither block headers nor free lists are touched
+ * during the search and adjacent free blocks don't have to be merged
+ * beforehand. A page map remembers which block covers the start of each page,
+ * which makes `block_of` constant-time.
+ *
+ * @note Needs the heap to be attached, so it can't be used with a static_heap
+ */
+class bitmap_fit {
+ public:
+  static constexpr auto requires_merge = false;
+
+  /// Granularity of the page map, in bytes
+  static constexpr std::size_t page_size = 4096;
+
+  auto attach(raw_ptr data, std::size_t size) -> void;
+
+  /**
+   * @return Header of the first free run of at least `block_size_of(size)`
+   * bytes, `length` is the number of scanned bitmap words
+   */
+  auto find(block_header* root, std::size_t size, std::size_t& length)
+      -> block_header*;
+
+  auto on_split(block_header* block, block_header* next) -> void;
+
+  auto on_merge(block_header* block, block_header* absorbed) -> void;
+
+  auto on_use(block_header* block) -> void;
+
+  auto on_release(block_header* block) -> void;
+
+  auto block_of(block_header* root, const void* address) const
+      -> block_header*;
+
+ private:
+  using bitmap_word = std::uint64_t;
+
+  static constexpr std::size_t bitmap_word_bits = 64;
+
+  auto word_of(const void* address) const -> std::size_t;
+
+  auto header_at(std::size_t word) const -> block_header*;
+
+  auto set_used(block_header* block, bool used) -> void;
+
+ private:
+  raw_ptr base_ = nullptr;
+  std::size_t words_ = 0;
+
+  std::vector<bitmap_word> used_;
+  std::vector<bitmap_word> starts_;
+
+  std::vector<block_header*> owners_;
+};
+
+}  // namespace s21::memory
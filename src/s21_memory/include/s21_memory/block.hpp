@@ -1,6 +1,8 @@
 #pragma once
 
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 
 namespace s21::memory {
 
@@ -13,15 +15,49 @@ constexpr auto align_of(std::size_t n) {
   return n + (word_size - n % word_size) % word_size;
 }
 
-enum class block_type { free, char_t, int_t, double_t };
+enum class block_type : unsigned char { free, char_t, int_t, double_t };
+
+/**
+ * @brief Expected lifetime of a block, short-lived blocks are placed at the
+ * start of the heap, long-lived and permanent ones share its end
+ */
+enum class block_lifetime : unsigned char {
+  short_lived,
+  long_lived,
+  permanent
+};
+
+constexpr auto lifetime_count = 3;
 
 struct alignas(word_size) block_header {
   block_type type;
+  block_lifetime lifetime = block_lifetime::short_lived;
+  /// Set once a shared block becomes read-only
+  std::atomic<bool> frozen = false;
+  /// Set while the block may be reclaimed under memory pressure
+  bool purgeable = false;
+  /// Number of references to a shared block, 0 if the block isn't shared
+  std::atomic<std::uint32_t> references = 0;
   std::size_t size;
 
   block_header* next = nullptr;
+  block_header* prev = nullptr;
+
+  constexpr block_header(block_type type, std::size_t size)
+      : type(type), size(size) {}
 
-  block_header(block_type type, std::size_t size) : type(type), size(size) {}
+  /**
+   * @brief Takes a snapshot of the header, e.g. to inspect it later
+   */
+  block_header(const block_header& other)
+      : type(other.type),
+        lifetime(other.lifetime),
+        frozen(other.frozen.load(std::memory_order_relaxed)),
+        purgeable(other.purgeable),
+        references(other.references.load(std::memory_order_relaxed)),
+        size(other.size),
+        next(other.next),
+        prev(other.prev) {}
 };
 
 constexpr auto block_size_of(std::size_t n) { return n + sizeof(block_header); }
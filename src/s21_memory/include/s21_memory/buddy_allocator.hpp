@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "s21_memory/block.hpp"
+#include "s21_memory/heap.hpp"
+
+namespace s21::memory {
+
+/**
+ * @brief Binary buddy system over a heap, an alternative to basic_allocator
+ * with the same block interface
+ *
+ * Blocks of order `k` take `min_block_size << k` bytes, header included, and
+ * start at a multiple of their size from the heap start, so the buddy of a
+ * block is found by flipping bit `k` of its offset. Free blocks of each order
+ * are kept in a free list linked through their headers, and every pair of
+ * buddies has a bit which holds whether exactly one of them is free, so the
+ * merge decision on free takes no header access. Allocation and free take
+ * O(log n) steps, at the cost of rounding blocks up to a power of two.
+ *
+ * A heap which is not a power of two multiple of `min_block_size` is covered
+ * by several top-level blocks of decreasing orders.
+ */
+class buddy_allocator {
+ public:
+  /// Size of an order 0 block, header included
+  static constexpr std::size_t min_block_size = 2 * sizeof(block_header);
+
+  buddy_allocator(std::size_t heap_size);
+
+  /**
+   * @throws std::bad_alloc if there is no free block large enough
+   */
+  auto allocate_block(std::size_t size, block_type type = block_type::char_t)
+      -> block_header*;
+
+  /**
+   * @return Allocated block or nullptr if there is no free block large enough
+   */
+  auto try_allocate_block(std::size_t size,
+                          block_type type = block_type::char_t) noexcept
+      -> block_header*;
+
+  /**
+   * @throws std::bad_alloc if the block can't be grown, the block stays valid
+   */
+  auto reallocate_block(block_header* block, std::size_t size) -> block_header*;
+
+  /**
+   * @brief Shrinks the block or grows it by absorbing free buddies in place,
+   * moves it only if that isn't possible
+   * @return Reallocated block, or nullptr if the block was freed because
+   * `size` is 0 or if it can't be grown, in which case it stays valid
+   */
+  auto try_reallocate_block(block_header* block, std::size_t size) noexcept
+      -> block_header*;
+
+  auto free_block(block_header* block) -> void;
+
+  auto size() const -> std::size_t;
+
+  auto blocks() const -> std::vector<block_header*>;
+
+ private:
+  using bitmap_word = std::uint64_t;
+
+  auto allocate(std::size_t size, block_type type) -> block_header*;
+
+  auto deallocate(block_header* block) -> void;
+
+  /**
+   * @return Lowest order of a block which holds `size` bytes of data
+   */
+  auto order_for(std::size_t size) const -> std::size_t;
+
+  auto order_of(const block_header* block) const -> std::size_t;
+
+  auto offset_of(const block_header* block) const -> std::size_t;
+
+  auto block_at(std::size_t offset) const -> block_header*;
+
+  /**
+   * @return Buddy of the block at `offset`, or nullptr if the buddy doesn't fit
+   * into the heap
+   */
+  auto buddy_of(std::size_t offset, std::size_t order) const -> block_header*;
+
+  /**
+   * @brief Flips the pair bit of the block
+   * @return true if exactly one block of the pair is free afterwards
+   */
+  auto toggle_pair(std::size_t offset, std::size_t order) -> bool;
+
+  auto pair_bit(std::size_t offset, std::size_t order) const -> bool;
+
+  auto push(block_header* block, std::size_t order) -> void;
+
+  auto remove(block_header* block, std::size_t order) -> void;
+
+  /**
+   * @brief Splits the block down to `order`, freeing the upper halves
+   */
+  auto split_down(block_header* block, std::size_t from, std::size_t to)
+      -> void;
+
+  auto grow_in_place(block_header* block, std::size_t order) -> bool;
+
+ private:
+  heap heap_;
+
+  /// Number of order 0 blocks in the heap
+  std::size_t units_;
+
+  std::vector<block_header*> free_lists_;
+
+  /// Pair bits of each order, indexed by `offset >> (order + 1)`
+  std::vector<std::vector<bitmap_word>> pairs_;
+};
+
+}  // namespace s21::memory
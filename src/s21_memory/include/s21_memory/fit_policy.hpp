@@ -0,0 +1,208 @@
+#pragma once
+
+#include <cstddef>
+
+#include "s21_memory/block.hpp"
+
+namespace s21::memory {
+
+/*
+ * Fit policies implement `find(root, size, length)`, which returns a free
+ * block of at least `size` bytes or nullptr and stores the amount of visited
+ * metadata into `length`, `block_of(root, address)`, which returns the
+ * allocated block containing `address`, and hooks which are called when the
+ * block list changes:
+ * - attach(data, size) - once the heap is created
+ * - on_split(block, next) - `next` is split off `block`
+ * - on_merge(block, absorbed) - `absorbed` stops being a separate block
+ * - on_use(block) / on_release(block) - block is allocated / freed
+ *
+ * If `requires_merge` is false, `find` may return the first of several
+ * adjacent free blocks which are large enough together.
+ */
+
+/**
+ * @brief Base of policies which search through the block list
+ */
+class list_fit {
+ public:
+  static constexpr auto requires_merge = true;
+
+  auto attach(raw_ptr, std::size_t) -> void {}
+
+  auto on_split(block_header*, block_header*) -> void {}
+
+  auto on_merge(block_header*, block_header*) -> void {}
+
+  auto on_use(block_header*) -> void {}
+
+  auto on_release(block_header*) -> void {}
+
+  auto block_of(block_header* root, const void* address) const
+      -> block_header*;
+};
+
+/**
+ * @brief Returns the first free block large enough for the request
+ */
+class first_fit : public list_fit {
+ public:
+  auto find(block_header* root, std::size_t size, std::size_t& length)
+      -> block_header*;
+};
+
+/**
+ * @brief First fit starting from where the previous search stopped
+ */
+class next_fit : public list_fit {
+ public:
+  auto find(block_header* root, std::size_t size, std::size_t& length)
+      -> block_header*;
+
+  auto on_merge(block_header* block, block_header* absorbed) -> void;
+
+ private:
+  block_header* rover_ = nullptr;
+};
+
+/**
+ * @brief Returns the smallest suitable free block, stops early on a block
+ * that is too small to be split
+ */
+class best_fit : public list_fit {
+ public:
+  auto find(block_header* root, std::size_t size, std::size_t& length)
+      -> block_header*;
+};
+
+/**
+ * @brief Returns the smallest suitable free block, unlike best_fit it always
+ * scans the whole list, so an exact fit wins over an earlier block which is
+ * merely too small to be split. The list is in address order, so ties go to
+ * the lowest address.
+ */
+class address_ordered_best_fit : public list_fit {
+ public:
+  auto find(block_header* root, std::size_t size, std::size_t& length)
+      -> block_header*;
+};
+
+inline auto is_fit(const block_header* block, std::size_t size) {
+  return block->type == block_type::free && block->size >= size;
+}
+
+inline auto list_fit::block_of(block_header* root,
+                               const void* address) const -> block_header* {
+  auto target = static_cast<const raw_byte*>(address);
+
+  for (auto block = root; block; block = block->next) {
+    if (target < reinterpret_cast<raw_ptr>(block)) {
+      break;
+    }
+
+    if (target < data_of(block) + block->size) {
+      return block->type == block_type::free ? nullptr : block;
+    }
+  }
+
+  return nullptr;
+}
+
+inline auto first_fit::find(block_header* root, std::size_t size,
+                            std::size_t& length) -> block_header* {
+  length = 0;
+
+  for (auto block = root; block; block = block->next) {
+    length++;
+
+    if (is_fit(block, size)) {
+      return block;
+    }
+  }
+
+  return nullptr;
+}
+
+inline auto next_fit::find(block_header* root, std::size_t size,
+                           std::size_t& length) -> block_header* {
+  auto start = rover_ ? rover_ : root;
+
+  length = 0;
+
+  for (auto block = start; block; block = block->next) {
+    length++;
+
+    if (is_fit(block, size)) {
+      rover_ = block;
+      return block;
+    }
+  }
+
+  for (auto block = root; block != start; block = block->next) {
+    length++;
+
+    if (is_fit(block, size)) {
+      rover_ = block;
+      return block;
+    }
+  }
+
+  return nullptr;
+}
+
+inline auto next_fit::on_merge(block_header* block, block_header* absorbed)
+    -> void {
+  if (rover_ == absorbed) {
+    rover_ = block;
+  }
+}
+
+inline auto best_fit::find(block_header* root, std::size_t size,
+                           std::size_t& length) -> block_header* {
+  block_header* result = nullptr;
+
+  length = 0;
+
+  for (auto block = root; block; block = block->next) {
+    length++;
+
+    if (!is_fit(block, size)) {
+      continue;
+    }
+
+    if (block->size < block_size_of(size)) {
+      return block;
+    }
+
+    if (!result || block->size < result->size) {
+      result = block;
+    }
+  }
+
+  return result;
+}
+
+inline auto address_ordered_best_fit::find(block_header* root,
+                                           std::size_t size,
+                                           std::size_t& length)
+    -> block_header* {
+  block_header* result = nullptr;
+
+  length = 0;
+
+  for (auto block = root; block; block = block->next) {
+    length++;
+
+    if (!is_fit(block, size)) {
+      continue;
+    }
+
+    if (!result || block->size < result->size) {
+      result = block;
+    }
+  }
+
+  return result;
+}
+
+}  // namespace s21::memory
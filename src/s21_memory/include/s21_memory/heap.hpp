@@ -1,7 +1,6 @@
 #pragma once
 
 #include <cstddef>
-#include <functional>
 #include <memory>
 
 #include "s21_memory/block.hpp"
@@ -10,6 +9,8 @@ namespace s21::memory {
 
 class heap {
  public:
+  static constexpr auto is_static = false;
+
   heap(std::size_t size);
 
   auto data() const -> raw_ptr;
@@ -17,9 +18,13 @@ class heap {
   auto size() const -> std::size_t;
 
  private:
+  struct free_deleter {
+    auto operator()(raw_ptr data) const -> void;
+  };
+
   std::size_t size_;
 
-  std::unique_ptr<raw_byte[], std::function<void(raw_ptr)>> data_;
+  std::unique_ptr<raw_byte[], free_deleter> data_;
 };
 
 }  // namespace s21::memory
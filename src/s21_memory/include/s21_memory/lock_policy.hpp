@@ -0,0 +1,61 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+
+namespace s21::memory {
+
+/**
+ * @brief Lock policy for single-threaded allocators
+ */
+class null_lock {
+ public:
+  auto lock() -> void {}
+
+  auto unlock() -> void {}
+};
+
+/**
+ * @brief Busy-waiting lock for short critical sections
+ * @note Moving a lock produces a new unlocked lock
+ */
+class spin_lock {
+ public:
+  spin_lock() = default;
+
+  spin_lock(spin_lock&&) noexcept {}
+
+  auto operator=(spin_lock&&) noexcept -> spin_lock& { return *this; }
+
+  auto lock() -> void {
+    while (flag_.test_and_set(std::memory_order_acquire)) {
+    }
+  }
+
+  auto unlock() -> void { flag_.clear(std::memory_order_release); }
+
+ private:
+  std::atomic_flag flag_ = ATOMIC_FLAG_INIT;
+};
+
+/**
+ * @brief Lock policy backed by std::mutex
+ * @note Moving a lock produces a new unlocked lock
+ */
+class mutex_lock {
+ public:
+  mutex_lock() = default;
+
+  mutex_lock(mutex_lock&&) noexcept {}
+
+  auto operator=(mutex_lock&&) noexcept -> mutex_lock& { return *this; }
+
+  auto lock() -> void { mutex_.lock(); }
+
+  auto unlock() -> void { mutex_.unlock(); }
+
+ private:
+  std::mutex mutex_;
+};
+
+}  // namespace s21::memory
@@ -0,0 +1,87 @@
+#pragma once
+
+/**
+ * Static tracing probes compatible with SystemTap SDT (USDT) notes.
+ *
+ * When S21_MEMORY_PROBES is defined every probe compiles to a single nop and
+ * an entry in the .note.stapsdt section under the `s21_memory` provider, so
+ * it can be attached with e.g. `bpftrace -e 'usdt:<binary>:s21_memory:*'`.
+ * Probes are only emitted by GCC-compatible compilers for ELF x86-64 and
+ * AArch64 targets, S21_MEMORY_PROBES_ENABLED is defined then. Otherwise
+ * probes compile to nothing. All arguments are passed as 8 byte unsigned
+ * integers.
+ */
+
+#include <cstdint>
+#include <type_traits>
+
+namespace s21::memory::internal {
+
+template <typename T>
+constexpr auto probe_arg(T value) -> std::uint64_t {
+  if constexpr (std::is_pointer_v<T>) {
+    return reinterpret_cast<std::uintptr_t>(value);
+  } else {
+    return static_cast<std::uint64_t>(value);
+  }
+}
+
+}  // namespace s21::memory::internal
+
+#if defined(S21_MEMORY_PROBES) && defined(__GNUC__) && defined(__ELF__) && \
+    (defined(__x86_64__) || defined(__aarch64__))
+
+#define S21_MEMORY_PROBES_ENABLED
+
+#define S21_PROBE_ASM(name, args)                                         \
+  "990: nop\n"                                                            \
+  ".pushsection .note.stapsdt,\"?\",\"note\"\n"                           \
+  ".balign 4\n"                                                           \
+  ".4byte 992f-991f, 994f-993f, 3\n"                                      \
+  "991: .asciz \"stapsdt\"\n"                                             \
+  "992: .balign 4\n"                                                      \
+  "993: .8byte 990b\n"                                                    \
+  ".8byte _.stapsdt.base\n"                                               \
+  ".8byte 0\n"                                                            \
+  ".asciz \"s21_memory\"\n"                                               \
+  ".asciz \"" #name "\"\n"                                                \
+  ".asciz \"" args "\"\n"                                                 \
+  "994: .balign 4\n"                                                      \
+  ".popsection\n"                                                         \
+  ".ifndef _.stapsdt.base\n"                                              \
+  ".pushsection .stapsdt.base,\"aG\",\"progbits\",.stapsdt.base,comdat\n" \
+  ".weak _.stapsdt.base\n"                                                \
+  ".hidden _.stapsdt.base\n"                                              \
+  "_.stapsdt.base: .space 1\n"                                            \
+  ".size _.stapsdt.base, 1\n"                                             \
+  ".popsection\n"                                                         \
+  ".endif\n"
+
+#define S21_PROBE_ARG(value) "nor"(s21::memory::internal::probe_arg(value))
+
+#define S21_PROBE1(name, a)                        \
+  __asm__ __volatile__(S21_PROBE_ASM(name, "8@%0") \
+                       :                           \
+                       : S21_PROBE_ARG(a))
+
+#define S21_PROBE2(name, a, b)                          \
+  __asm__ __volatile__(S21_PROBE_ASM(name, "8@%0 8@%1") \
+                       :                                \
+                       : S21_PROBE_ARG(a), S21_PROBE_ARG(b))
+
+#define S21_PROBE3(name, a, b, c)                            \
+  __asm__ __volatile__(S21_PROBE_ASM(name, "8@%0 8@%1 8@%2") \
+                       :                                     \
+                       : S21_PROBE_ARG(a), S21_PROBE_ARG(b), S21_PROBE_ARG(c))
+
+#else
+
+#define S21_PROBE1(name, a) static_cast<void>(a)
+
+#define S21_PROBE2(name, a, b) \
+  (static_cast<void>(a), static_cast<void>(b))
+
+#define S21_PROBE3(name, a, b, c) \
+  (static_cast<void>(a), static_cast<void>(b), static_cast<void>(c))
+
+#endif
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "s21_memory/block.hpp"
+
+namespace s21::memory {
+
+/**
+ * @brief Purge policy that keeps all heap pages resident
+ */
+class no_purge {
+ public:
+  auto attach(raw_ptr, std::size_t) -> void {}
+
+  auto on_commit(raw_ptr, raw_ptr) -> void {}
+
+  auto should_tick() -> bool { return false; }
+
+  auto tick(block_header*, bool) -> void {}
+
+  auto purged() const -> std::size_t { return 0; }
+};
+
+/**
+ * @brief Returns whole pages of free blocks to the OS once they have stayed
+ * free for at least one decay period
+ *
+ * Ticks are driven by allocations, reallocations and frees alike. The clock is
+ * read only every `clock_interval` operations, so most operations pay for a
+ * counter increment only.
+ *
+ * Pages are recommitted transparently by the kernel on first access, the
+ * policy only keeps track of them for statistics.
+ */
+class decay_purge {
+ public:
+  using clock = std::chrono::steady_clock;
+
+  /// Number of operations between clock reads, every operation reads the
+  /// clock if the decay is zero
+  static constexpr std::uint32_t clock_interval = 16;
+
+  decay_purge(clock::duration decay = std::chrono::seconds(10));
+
+  auto attach(raw_ptr data, std::size_t size) -> void;
+
+  auto set_decay(clock::duration decay) -> void;
+
+  auto on_commit(raw_ptr begin, raw_ptr end) -> void;
+
+  /**
+   * @brief Counts an operation and checks whether a decay period has elapsed
+   * since the last tick
+   */
+  auto should_tick() -> bool;
+
+  /**
+   * @brief Purges pages of free blocks which were already idle on the
+   * previous tick, or all of them if `force` is set
+   */
+  auto tick(block_header* root, bool force) -> void;
+
+  auto purged() const -> std::size_t;
+
+ private:
+  enum class page_state : unsigned char { resident, idle, purged };
+
+  auto purge_pages(std::size_t first, std::size_t last) -> void;
+
+ private:
+  clock::duration decay_;
+  clock::time_point last_tick_;
+  std::uint32_t operations_ = 0;
+
+  raw_ptr base_ = nullptr;
+  std::size_t page_size_ = 0;
+
+  std::vector<page_state> pages_;
+  std::size_t purged_pages_ = 0;
+};
+
+}  // namespace s21::memory
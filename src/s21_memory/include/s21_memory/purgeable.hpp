@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <optional>
+#include <unordered_map>
+
+#include "s21_memory/block.hpp"
+
+namespace s21::memory {
+
+/**
+ * @brief Called with the data of a purgeable block after it was reclaimed,
+ * the memory must not be accessed anymore
+ */
+using purge_callback = void (*)(void* block, void* context);
+
+struct purged_block {
+  block_header* block;
+  purge_callback callback;
+  void* context;
+};
+
+/**
+ * @brief Registry of purgeable blocks which the allocator may reclaim when it
+ * runs out of memory
+ *
+ * A block is pinned while its owner uses it and can't be reclaimed then.
+ * Unpinned blocks are kept in LRU order of their last unpin, so the block
+ * whose owner touched it longest ago is reclaimed first. The registry doesn't
+ * free blocks itself, it only picks them.
+ */
+class purgeable_blocks {
+ public:
+  /**
+   * @brief Registers the block pinned once, so it can be filled before it
+   * becomes purgeable
+   * @throws std::bad_alloc if the registry can't grow
+   */
+  auto add(block_header* block, purge_callback callback, void* context)
+      -> void;
+
+  /**
+   * @brief Forgets the block, e.g. when its owner frees it
+   */
+  auto remove(block_header* block) -> void;
+
+  /**
+   * @return false if the block isn't registered, e.g. because it was purged
+   */
+  auto pin(block_header* block) -> bool;
+
+  /**
+   * @return false if the block isn't registered or isn't pinned
+   * @throws std::bad_alloc if the LRU list can't grow, the block stays pinned
+   */
+  auto unpin(block_header* block) -> bool;
+
+  /**
+   * @brief Unregisters the least recently unpinned block
+   * @return The block, or nothing if every block is pinned
+   */
+  auto evict() -> std::optional<purged_block>;
+
+  auto clear() -> void;
+
+  auto size() const -> std::size_t;
+
+  /**
+   * @return Number of blocks evicted so far
+   */
+  auto purged() const -> std::size_t;
+
+ private:
+  using lru_list = std::list<block_header*>;
+
+  struct entry {
+    std::uint32_t pins;
+    purge_callback callback;
+    void* context;
+    /// Position in the LRU list, valid only while the block is unpinned
+    lru_list::iterator position;
+  };
+
+  std::unordered_map<block_header*, entry> entries_;
+
+  /// Unpinned blocks, least recently unpinned first
+  lru_list lru_;
+
+  std::size_t purged_ = 0;
+};
+
+}  // namespace s21::memory
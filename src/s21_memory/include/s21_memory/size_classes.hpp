@@ -0,0 +1,100 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "s21_memory/block.hpp"
+
+namespace s21::memory {
+
+struct size_class_stats {
+  /// Number of times the table was re-derived
+  std::size_t retunes;
+  /// Bytes requested by the allocations seen before the last retune
+  std::size_t requested;
+  /// Bytes the same allocations take when rounded by the previous table
+  std::size_t before;
+  /// Bytes the same allocations take when rounded by the current table
+  std::size_t after;
+};
+
+/**
+ * @brief Size classes learned from a histogram of requested sizes
+ *
+ * Requests up to `max_size` bytes are rounded up to the smallest class which
+ * fits them, so freed blocks are reused by requests of the same class instead
+ * of being split into unusable slivers. Every `interval` recorded requests
+ * the table is re-derived to minimise the internal fragmentation of the
+ * observed mix, and the histogram is halved so that it follows changes of
+ * the workload. The table starts empty, so requests are only aligned until
+ * the first retune. Neither retune nor set_table allocates, so they can run
+ * inside noexcept malloc.
+ */
+class size_classes {
+ public:
+  /// Largest size which is rounded to a class, larger requests are not
+  static constexpr std::size_t max_size = 512;
+  /// Largest number of classes in a table
+  static constexpr std::size_t max_classes = 8;
+
+  size_classes(std::size_t interval = 1024);
+
+  /**
+   * @brief Adds the request to the histogram
+   * @return true if the table was re-derived
+   */
+  auto record(std::size_t size) -> bool;
+
+  /**
+   * @return Size of the smallest class which fits `size`, or `size` aligned
+   * to the word size if there is none
+   */
+  auto round(std::size_t size) const -> std::size_t;
+
+  /**
+   * @brief Re-derives the table from the current histogram
+   */
+  auto retune() -> void;
+
+  /**
+   * @return Remainder of a block which is too small to hold any class
+   */
+  auto split_threshold() const -> std::size_t;
+
+  auto table() const -> const std::vector<std::size_t>&;
+
+  /**
+   * @brief Replaces the table, e.g. with one exported by a previous run
+   * @return false if `table` isn't strictly increasing, has more than
+   * `max_classes` entries or entries that are not word-aligned, zero or
+   * larger than `max_size`, the current table is kept then
+   */
+  auto set_table(const std::vector<std::size_t>& table) -> bool;
+
+  auto stats() const -> size_class_stats;
+
+ private:
+  static constexpr auto bins = max_size / word_size;
+
+  /**
+   * @return Bytes taken by the requests in the histogram when rounded by
+   * `table`
+   */
+  auto rounded_size(const std::vector<std::size_t>& table) const
+      -> std::size_t;
+
+ private:
+  std::size_t interval_;
+  std::size_t recorded_ = 0;
+
+  /// Number of requests of each aligned size, bin `i` holds `(i + 1)` words
+  std::array<std::uint64_t, bins> histogram_ = {};
+
+  std::vector<std::size_t> table_;
+
+  size_class_stats stats_ = {};
+};
+
+}  // namespace s21::memory
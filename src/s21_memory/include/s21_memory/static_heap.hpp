@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+
+#include "s21_memory/block.hpp"
+
+namespace s21::memory {
+
+/**
+ * @brief Heap with inline storage of N bytes
+ *
+ * The root block header is constant-initialized together with the storage,
+ * so a static_heap (and an allocator over it) may be a global with no
+ * dynamic initialization. Note that the whole storage then lives in the data
+ * section of the binary.
+ */
+template <std::size_t N>
+class static_heap {
+  static_assert(N >= sizeof(block_header),
+                "static_heap must fit at least one block header");
+
+ public:
+  static constexpr auto is_static = true;
+
+  constexpr static_heap() = default;
+
+  static_heap(const static_heap&) = delete;
+  auto operator=(const static_heap&) -> static_heap& = delete;
+
+  constexpr auto root() -> block_header* { return &storage_.root; }
+
+  auto data() const -> raw_ptr {
+    return reinterpret_cast<raw_ptr>(const_cast<storage*>(&storage_));
+  }
+
+  constexpr auto size() const -> std::size_t { return N; }
+
+ private:
+  union storage {
+    constexpr storage()
+        : root(block_type::free,
+               (N - sizeof(block_header)) / word_size * word_size) {}
+
+    block_header root;
+    raw_byte bytes[N];
+  };
+
+  alignas(alignof(std::max_align_t)) storage storage_;
+};
+
+}  // namespace s21::memory
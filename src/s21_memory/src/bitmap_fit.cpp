@@ -0,0 +1,196 @@
+#include "s21_memory/bitmap_fit.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "s21_memory/block.hpp"
+
+namespace s21::memory {
+
+namespace {
+
+constexpr auto page_words = bitmap_fit::page_size / word_size;
+
+/**
+ * @return Mask of bits [first, last) of a bitmap word, `last` may be 64
+ */
+auto bit_mask(std::size_t first, std::size_t last) -> std::uint64_t {
+  auto upper = last == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << last) - 1;
+
+  return upper & ~((std::uint64_t(1) << first) - 1);
+}
+
+auto set_bits(std::vector<std::uint64_t>& bitmap, std::size_t first,
+              std::size_t last, bool value) -> void {
+  while (first < last) {
+    auto index = first / 64;
+    auto end = index * 64 + 64 < last ? 64 : last - index * 64;
+    auto mask = bit_mask(first % 64, end);
+
+    if (value) {
+      bitmap[index] |= mask;
+    } else {
+      bitmap[index] &= ~mask;
+    }
+
+    first = index * 64 + end;
+  }
+}
+
+auto test_bit(const std::vector<std::uint64_t>& bitmap, std::size_t bit) {
+  return (bitmap[bit / 64] >> (bit % 64)) & 1;
+}
+
+}  // namespace
+
+auto bitmap_fit::attach(raw_ptr data, std::size_t size) -> void {
+  base_ = data;
+  words_ = size / word_size;
+
+  auto bitmap_words = (words_ + bitmap_word_bits - 1) / bitmap_word_bits;
+
+  used_.assign(bitmap_words, 0);
+  starts_.assign(bitmap_words, 0);
+  owners_.assign((words_ + page_words - 1) / page_words, nullptr);
+
+  // Bits past the end of the heap are never free
+  set_bits(used_, words_, bitmap_words * bitmap_word_bits, true);
+
+  if (words_ > 0) {
+    set_bits(starts_, 0, 1, true);
+  }
+}
+
+auto bitmap_fit::find(block_header*, std::size_t size, std::size_t& length)
+    -> block_header* {
+  auto required = (block_size_of(size) + word_size - 1) / word_size;
+
+  auto run_start = std::size_t(0);
+  auto run = std::size_t(0);
+
+  length = 0;
+
+  for (auto index = std::size_t(0); index < used_.size(); index++) {
+    length++;
+
+    auto free = ~used_[index];
+    auto bit = std::size_t(0);
+
+    while (bit < bitmap_word_bits) {
+      auto rest = free >> bit;
+
+      if (!rest) {
+        run = 0;
+        break;
+      }
+
+      auto skipped = static_cast<std::size_t>(__builtin_ctzll(rest));
+
+      if (skipped > 0) {
+        run = 0;
+        bit += skipped;
+        rest >>= skipped;
+      }
+
+      // Bits shifted in from the top are zero, so the inversion is all zero
+      // only if the whole word is free
+      auto ones = ~rest ? static_cast<std::size_t>(__builtin_ctzll(~rest))
+                        : bitmap_word_bits - bit;
+
+      if (run == 0) {
+        run_start = index * bitmap_word_bits + bit;
+      }
+
+      run += ones;
+      bit += ones;
+
+      if (run >= required) {
+        return header_at(run_start);
+      }
+    }
+  }
+
+  return nullptr;
+}
+
+auto bitmap_fit::on_split(block_header*, block_header* next) -> void {
+  auto word = word_of(next);
+
+  set_bits(starts_, word, word + 1, true);
+}
+
+auto bitmap_fit::on_merge(block_header*, block_header* absorbed) -> void {
+  auto word = word_of(absorbed);
+
+  set_bits(starts_, word, word + 1, false);
+}
+
+auto bitmap_fit::on_use(block_header* block) -> void {
+  set_used(block, true);
+
+  auto first = word_of(block);
+  auto last = word_of(data_of(block) + block->size + word_size - 1);
+
+  for (auto page = (first + page_words - 1) / page_words;
+       page * page_words < last && page < owners_.size(); page++) {
+    owners_[page] = block;
+  }
+}
+
+auto bitmap_fit::on_release(block_header* block) -> void {
+  set_used(block, false);
+}
+
+auto bitmap_fit::block_of(block_header*, const void* address) const
+    -> block_header* {
+  auto target = static_cast<const raw_byte*>(address);
+
+  if (target < base_ || target >= base_ + words_ * word_size) {
+    return nullptr;
+  }
+
+  auto word = word_of(target);
+
+  if (!test_bit(used_, word)) {
+    return nullptr;
+  }
+
+  // The closest header at or before the word is the owning block, the scan is
+  // bounded by the start of the page
+  auto page_start = word / page_words * page_words;
+  auto index = word / bitmap_word_bits;
+  auto starts = starts_[index] & bit_mask(0, word % bitmap_word_bits + 1);
+
+  while (!starts && index * bitmap_word_bits > page_start) {
+    starts = starts_[--index];
+  }
+
+  if (!starts) {
+    return owners_[word / page_words];
+  }
+
+  auto last = bitmap_word_bits - 1 -
+              static_cast<std::size_t>(__builtin_clzll(starts));
+
+  return header_at(index * bitmap_word_bits + last);
+}
+
+auto bitmap_fit::word_of(const void* address) const -> std::size_t {
+  return static_cast<std::size_t>(static_cast<const raw_byte*>(address) -
+                                  base_) /
+         word_size;
+}
+
+auto bitmap_fit::header_at(std::size_t word) const -> block_header* {
+  return reinterpret_cast<block_header*>(base_ + word * word_size);
+}
+
+auto bitmap_fit::set_used(block_header* block, bool used) -> void {
+  auto first = word_of(block);
+  auto last = word_of(data_of(block) + block->size + word_size - 1);
+
+  set_bits(used_, first, last < words_ ? last : words_, used);
+}
+
+}  // namespace s21::memory
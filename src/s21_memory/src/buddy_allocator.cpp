@@ -0,0 +1,333 @@
+#include "s21_memory/buddy_allocator.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <vector>
+
+#include "s21_memory/block.hpp"
+#include "s21_memory/probe.hpp"
+
+namespace s21::memory {
+
+namespace {
+
+constexpr auto bitmap_word_bits = std::size_t(64);
+
+constexpr auto units_of(std::size_t order) { return std::size_t(1) << order; }
+
+constexpr auto data_size_of(std::size_t order) {
+  return buddy_allocator::min_block_size * units_of(order) -
+         sizeof(block_header);
+}
+
+}  // namespace
+
+buddy_allocator::buddy_allocator(std::size_t heap_size)
+    : heap_(std::max(heap_size, min_block_size)),
+      units_(heap_.size() / min_block_size) {
+  auto orders = std::size_t(1);
+
+  while (units_of(orders) <= units_) {
+    orders++;
+  }
+
+  free_lists_.assign(orders, nullptr);
+  pairs_.resize(orders);
+
+  for (auto order = std::size_t(0); order < orders; order++) {
+    auto pairs = (units_ >> (order + 1)) + 1;
+
+    pairs_[order].assign((pairs + bitmap_word_bits - 1) / bitmap_word_bits, 0);
+  }
+
+  // Buddies of the top-level blocks never fit into the heap, so their pair
+  // bits are never used
+  auto offset = std::size_t(0);
+
+  for (auto order = orders; order-- > 0;) {
+    if (units_ - offset >= units_of(order)) {
+      push(block_at(offset), order);
+
+      offset += units_of(order);
+    }
+  }
+}
+
+auto buddy_allocator::allocate_block(std::size_t size, block_type type)
+    -> block_header* {
+  auto block = try_allocate_block(size, type);
+
+  if (!block) {
+    throw std::bad_alloc();
+  }
+
+  return block;
+}
+
+auto buddy_allocator::try_allocate_block(std::size_t size,
+                                         block_type type) noexcept
+    -> block_header* {
+  return allocate(size, type);
+}
+
+auto buddy_allocator::reallocate_block(block_header* block, std::size_t size)
+    -> block_header* {
+  auto result = try_reallocate_block(block, size);
+
+  if (!result && block && size != 0) {
+    throw std::bad_alloc();
+  }
+
+  return result;
+}
+
+auto buddy_allocator::try_reallocate_block(block_header* block,
+                                           std::size_t size) noexcept
+    -> block_header* {
+  if (!block) {
+    return nullptr;
+  }
+
+  if (size == 0) {
+    deallocate(block);
+
+    return nullptr;
+  }
+
+  auto order = order_for(size);
+  auto current = order_of(block);
+
+  if (order <= current) {
+    split_down(block, current, order);
+
+    return block;
+  }
+
+  if (grow_in_place(block, order)) {
+    S21_PROBE3(realloc_in_place, block, block, size);
+
+    return block;
+  }
+
+  auto next_block = allocate(size, block->type);
+
+  if (!next_block) {
+    return nullptr;
+  }
+
+  std::memcpy(data_of(next_block), data_of(block), block->size);
+
+  S21_PROBE3(realloc_move, block, next_block, size);
+
+  deallocate(block);
+
+  return next_block;
+}
+
+auto buddy_allocator::free_block(block_header* block) -> void {
+  if (!block) {
+    return;
+  }
+
+  deallocate(block);
+}
+
+auto buddy_allocator::size() const -> std::size_t { return heap_.size(); }
+
+auto buddy_allocator::blocks() const -> std::vector<block_header*> {
+  auto result = std::vector<block_header*>();
+
+  for (auto offset = std::size_t(0); offset < units_;) {
+    auto block = block_at(offset);
+
+    result.push_back(block);
+
+    offset += block_size_of(block->size) / min_block_size;
+  }
+
+  return result;
+}
+
+auto buddy_allocator::allocate(std::size_t size, block_type type)
+    -> block_header* {
+  auto order = order_for(size);
+  auto from = order;
+
+  while (from < free_lists_.size() && !free_lists_[from]) {
+    from++;
+  }
+
+  if (from >= free_lists_.size()) {
+    S21_PROBE2(out_of_memory, size, from - order);
+
+    return nullptr;
+  }
+
+  auto block = free_lists_[from];
+  auto offset = offset_of(block);
+
+  remove(block, from);
+
+  if (buddy_of(offset, from)) {
+    toggle_pair(offset, from);
+  }
+
+  split_down(block, from, order);
+
+  block->type = type;
+
+  S21_PROBE3(allocate, block, block->size, from - order);
+
+  return block;
+}
+
+auto buddy_allocator::deallocate(block_header* block) -> void {
+  auto order = order_of(block);
+  auto offset = offset_of(block);
+
+  S21_PROBE2(free, block, block->size);
+
+  // A cleared pair bit means that the buddy is free too
+  while (auto buddy = buddy_of(offset, order)) {
+    if (toggle_pair(offset, order)) {
+      break;
+    }
+
+    remove(buddy, order);
+
+    offset &= ~units_of(order);
+    order++;
+
+    S21_PROBE2(merge, block_at(offset), data_size_of(order));
+  }
+
+  push(block_at(offset), order);
+}
+
+auto buddy_allocator::order_for(std::size_t size) const -> std::size_t {
+  auto units = (block_size_of(align_of(size)) + min_block_size - 1) /
+               min_block_size;
+
+  auto order = std::size_t(0);
+
+  while (units_of(order) < units) {
+    order++;
+  }
+
+  return order;
+}
+
+auto buddy_allocator::order_of(const block_header* block) const
+    -> std::size_t {
+  auto units = block_size_of(block->size) / min_block_size;
+
+  return static_cast<std::size_t>(__builtin_ctzll(units));
+}
+
+auto buddy_allocator::offset_of(const block_header* block) const
+    -> std::size_t {
+  return static_cast<std::size_t>(reinterpret_cast<const raw_byte*>(block) -
+                                  heap_.data()) /
+         min_block_size;
+}
+
+auto buddy_allocator::block_at(std::size_t offset) const -> block_header* {
+  return reinterpret_cast<block_header*>(heap_.data() +
+                                         offset * min_block_size);
+}
+
+auto buddy_allocator::buddy_of(std::size_t offset, std::size_t order) const
+    -> block_header* {
+  auto buddy = offset ^ units_of(order);
+
+  if (buddy + units_of(order) > units_) {
+    return nullptr;
+  }
+
+  return block_at(buddy);
+}
+
+auto buddy_allocator::toggle_pair(std::size_t offset, std::size_t order)
+    -> bool {
+  auto pair = offset >> (order + 1);
+  auto& word = pairs_[order][pair / bitmap_word_bits];
+
+  word ^= bitmap_word(1) << (pair % bitmap_word_bits);
+
+  return (word >> (pair % bitmap_word_bits)) & 1;
+}
+
+auto buddy_allocator::pair_bit(std::size_t offset, std::size_t order) const
+    -> bool {
+  auto pair = offset >> (order + 1);
+
+  return (pairs_[order][pair / bitmap_word_bits] >> (pair % bitmap_word_bits)) &
+         1;
+}
+
+auto buddy_allocator::push(block_header* block, std::size_t order) -> void {
+  block = new (block) block_header(block_type::free, data_size_of(order));
+
+  block->next = free_lists_[order];
+
+  if (block->next) {
+    block->next->prev = block;
+  }
+
+  free_lists_[order] = block;
+}
+
+auto buddy_allocator::remove(block_header* block, std::size_t order) -> void {
+  if (block->prev) {
+    block->prev->next = block->next;
+  } else {
+    free_lists_[order] = block->next;
+  }
+
+  if (block->next) {
+    block->next->prev = block->prev;
+  }
+}
+
+auto buddy_allocator::split_down(block_header* block, std::size_t from,
+                                 std::size_t to) -> void {
+  auto offset = offset_of(block);
+
+  while (from > to) {
+    from--;
+
+    push(block_at(offset + units_of(from)), from);
+    toggle_pair(offset, from);
+
+    S21_PROBE3(split, block, data_size_of(from), data_size_of(from));
+  }
+
+  block->size = data_size_of(to);
+}
+
+auto buddy_allocator::grow_in_place(block_header* block, std::size_t order)
+    -> bool {
+  auto offset = offset_of(block);
+  auto current = order_of(block);
+
+  // The block is allocated, so a set pair bit means that the buddy is free
+  for (auto level = current; level < order; level++) {
+    if ((offset & units_of(level)) || !buddy_of(offset, level) ||
+        !pair_bit(offset, level)) {
+      return false;
+    }
+  }
+
+  for (auto level = current; level < order; level++) {
+    remove(buddy_of(offset, level), level);
+    toggle_pair(offset, level);
+  }
+
+  block->size = data_size_of(order);
+
+  return true;
+}
+
+}  // namespace s21::memory
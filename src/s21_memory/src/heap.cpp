@@ -5,7 +5,7 @@
 
 namespace s21::memory {
 
-heap::heap(std::size_t size) : size_(size), data_(nullptr, std::free) {
+heap::heap(std::size_t size) : size_(size) {
   auto data = std::malloc(size);
 
   if (!data) {
@@ -15,6 +15,10 @@ heap::heap(std::size_t size) : size_(size), data_(nullptr, std::free) {
   data_.reset(reinterpret_cast<raw_ptr>(data));
 }
 
+auto heap::free_deleter::operator()(raw_ptr data) const -> void {
+  std::free(data);
+}
+
 auto heap::data() const -> raw_ptr { return data_.get(); }
 
 auto heap::size() const -> std::size_t { return size_; }
@@ -1,47 +1,193 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstring>
 #include <new>
 #include <optional>
+#include <thread>
+#include <vector>
 
 #include "s21_memory.h"
 #include "s21_memory.hpp"
 #include "s21_memory/allocator.hpp"
 #include "s21_memory/block.hpp"
+#include "s21_memory/probe.hpp"
+#include "s21_memory/purgeable.hpp"
+#include "s21_memory/size_classes.hpp"
 
 #ifndef S21_MEMORY_DEFAULT_HEAP_SIZE
 #define S21_MEMORY_DEFAULT_HEAP_SIZE 4096
 #endif
 
+#ifndef S21_MEMORY_DEFAULT_DECAY_MS
+#define S21_MEMORY_DEFAULT_DECAY_MS 10000
+#endif
+
+#ifndef S21_MEMORY_SIZE_CLASS_INTERVAL
+#define S21_MEMORY_SIZE_CLASS_INTERVAL 1024
+#endif
+
+static_assert(S21_LIFETIME_COUNT == s21::memory::lifetime_count);
+
 namespace s21 {
 
 namespace memory::internal {
 
 std::optional<memory::allocator> default_allocator = std::nullopt;
 
-}
+std::chrono::milliseconds default_decay =
+    std::chrono::milliseconds(S21_MEMORY_DEFAULT_DECAY_MS);
+
+memory::size_classes default_size_classes =
+    memory::size_classes(S21_MEMORY_SIZE_CLASS_INTERVAL);
+
+memory::purgeable_blocks default_purgeable = memory::purgeable_blocks();
+
+}  // namespace memory::internal
+
+namespace {
+
+/// Thread which created the default heap, others must not free into it
+std::thread::id heap_owner = std::thread::id();
+
+/// Shared blocks whose last reference was dropped on another thread, linked
+/// through their data and freed by the heap owner on its next call
+std::atomic<memory::block_header*> deferred_frees = nullptr;
+
+}  // namespace
 
 auto set_heap(std::size_t size) -> void {
   memory::internal::default_allocator = memory::allocator(size);
+  memory::internal::default_purgeable.clear();
+
+  heap_owner = std::this_thread::get_id();
+  deferred_frees.store(nullptr, std::memory_order_relaxed);
+
+  memory::internal::default_allocator->purger().set_decay(
+      memory::internal::default_decay);
+  memory::internal::default_allocator->set_split_threshold(
+      memory::internal::default_size_classes.split_threshold());
+
+  S21_PROBE1(set_heap, size);
 }
 
-auto malloc(std::size_t size) -> void* {
-  if (!memory::internal::default_allocator) {
-    set_heap(S21_MEMORY_DEFAULT_HEAP_SIZE);
+namespace {
+
+auto next_deferred(memory::block_header* block) -> memory::block_header*& {
+  return *reinterpret_cast<memory::block_header**>(memory::data_of(block));
+}
+
+/**
+ * @brief Frees the shared blocks released on other threads, has to be called
+ * by the heap owner
+ */
+auto free_deferred() noexcept -> void {
+  // Skips the read-modify-write on the common path
+  if (!deferred_frees.load(std::memory_order_relaxed)) {
+    return;
   }
 
-  try {
-    auto block = memory::internal::default_allocator->allocate_block(size);
+  auto block = deferred_frees.exchange(nullptr, std::memory_order_acquire);
 
-    return memory::data_of(block);
-  } catch (std::bad_alloc&) {
-    return nullptr;
+  while (block) {
+    auto next = next_deferred(block);
+
+    memory::internal::default_allocator->free_block(block);
+
+    block = next;
   }
 }
 
-auto calloc(std::size_t n, std::size_t size) -> void* {
+/**
+ * @brief Returns the default allocator, creating it on first use
+ * @return nullptr if the default heap can't be allocated
+ */
+auto default_allocator() noexcept -> memory::allocator* {
   if (!memory::internal::default_allocator) {
-    set_heap(S21_MEMORY_DEFAULT_HEAP_SIZE);
+    try {
+      set_heap(S21_MEMORY_DEFAULT_HEAP_SIZE);
+    } catch (std::bad_alloc&) {
+      return nullptr;
+    }
   }
 
+  free_deferred();
+
+  return &*memory::internal::default_allocator;
+}
+
+/**
+ * @brief Calls `allocate` until it succeeds, reclaiming unpinned purgeable
+ * blocks in LRU order while it fails
+ * @return Result of the last call, nullptr if there is nothing left to reclaim
+ */
+template <typename Allocate>
+auto reclaim(memory::allocator* allocator, Allocate allocate) noexcept
+    -> memory::block_header* {
+  auto block = allocate();
+
+  while (!block) {
+    auto purged = memory::internal::default_purgeable.evict();
+
+    if (!purged) {
+      break;
+    }
+
+    auto data = memory::data_of(purged->block);
+
+    allocator->free_block(purged->block);
+
+    S21_PROBE1(purgeable_reclaimed, data);
+
+    // The registry is consistent again, the owner may allocate from here
+    if (purged->callback) {
+      purged->callback(data, purged->context);
+    }
+
+    block = allocate();
+  }
+
+  return block;
+}
+
+}  // namespace
+
+auto malloc(std::size_t size) noexcept -> void* {
+  return malloc_hint(size, memory::block_lifetime::short_lived);
+}
+
+auto malloc_hint(std::size_t size, memory::block_lifetime lifetime) noexcept
+    -> void* {
+  auto allocator = default_allocator();
+
+  if (!allocator) {
+    return nullptr;
+  }
+
+  auto& classes = memory::internal::default_size_classes;
+
+  if (classes.record(size)) {
+    allocator->set_split_threshold(classes.split_threshold());
+
+    S21_PROBE2(size_classes_retuned, classes.stats().before,
+               classes.stats().after);
+  }
+
+  auto block = reclaim(allocator, [&] {
+    return allocator->try_allocate_block(size, memory::block_type::char_t,
+                                         lifetime);
+  });
+
+  if (!block) {
+    S21_PROBE1(malloc_failed, size);
+
+    return nullptr;
+  }
+
+  return memory::data_of(block);
+}
+
+auto calloc(std::size_t n, std::size_t size) noexcept -> void* {
   if (n == 0 || size == 0) {
     return nullptr;
   }
@@ -63,41 +209,409 @@ auto calloc(std::size_t n, std::size_t size) -> void* {
   return result;
 }
 
-auto realloc(void* block, std::size_t size) -> void* {
+auto realloc(void* block, std::size_t size) noexcept -> void* {
+  if (!block) {
+    return malloc(size);
+  }
+
+  auto allocator = default_allocator();
+
+  if (!allocator) {
+    return nullptr;
+  }
+
+  auto header = memory::header_of(block);
+
+  if (header->references.load(std::memory_order_relaxed) != 0) {
+    if (size == 0) {
+      release(block);
+    } else {
+      S21_PROBE2(realloc_failed, block, size);
+    }
+
+    return nullptr;
+  }
+
+  if (header->purgeable) {
+    if (size == 0) {
+      free(block);
+    } else {
+      S21_PROBE2(realloc_failed, block, size);
+    }
+
+    return nullptr;
+  }
+
+  auto result = size == 0
+                    ? allocator->try_reallocate_block(header, size)
+                    : reclaim(allocator, [&] {
+                        return allocator->try_reallocate_block(header, size);
+                      });
+
+  if (!result) {
+    if (size != 0) {
+      S21_PROBE2(realloc_failed, block, size);
+    }
+
+    return nullptr;
+  }
+
+  return memory::data_of(result);
+}
+
+auto free(void* block) noexcept -> void {
+  if (!block) {
+    return;
+  }
+
   if (!memory::internal::default_allocator) {
-    set_heap(S21_MEMORY_DEFAULT_HEAP_SIZE);
+    return;
   }
 
-  try {
-    auto result = memory::internal::default_allocator->reallocate_block(
-        memory::header_of(block), size);
+  free_deferred();
+
+  auto header = memory::header_of(block);
+
+  if (header->references.load(std::memory_order_relaxed) != 0) {
+    release(block);
+
+    return;
+  }
+
+  if (header->purgeable) {
+    memory::internal::default_purgeable.remove(header);
+  }
+
+  memory::internal::default_allocator->free_block(header);
+}
+
+auto malloc_shared(std::size_t size) noexcept -> void* {
+  // Leaves room to link the block into the deferred frees
+  auto result = malloc(std::max(size, sizeof(memory::block_header*)));
+
+  if (!result) {
+    return nullptr;
+  }
+
+  memory::header_of(result)->references.store(1, std::memory_order_relaxed);
+
+  return result;
+}
+
+auto retain(void* block) noexcept -> void* {
+  if (!block) {
+    return nullptr;
+  }
+
+  auto& references = memory::header_of(block)->references;
+
+  if (references.load(std::memory_order_relaxed) == 0) {
+    return nullptr;
+  }
+
+  references.fetch_add(1, std::memory_order_relaxed);
+
+  return block;
+}
+
+auto release(void* block) noexcept -> void {
+  if (!block) {
+    return;
+  }
+
+  auto header = memory::header_of(block);
+
+  if (header->references.load(std::memory_order_relaxed) == 0) {
+    return;
+  }
+
+  // Writes of every owner happen before the block is freed by the last one
+  if (header->references.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+    return;
+  }
+
+  S21_PROBE1(shared_released, block);
+
+  if (!memory::internal::default_allocator) {
+    return;
+  }
 
-    return memory::data_of(result);
+  if (std::this_thread::get_id() == heap_owner) {
+    memory::internal::default_allocator->free_block(header);
+
+    return;
+  }
+
+  // The default allocator isn't locked, so the owner frees the block instead
+  auto& next = next_deferred(header);
+
+  next = deferred_frees.load(std::memory_order_relaxed);
+
+  while (!deferred_frees.compare_exchange_weak(
+      next, header, std::memory_order_release, std::memory_order_relaxed)) {
+  }
+}
+
+auto freeze(void* block) noexcept -> bool {
+  if (!block) {
+    return false;
+  }
+
+  auto header = memory::header_of(block);
+
+  if (header->references.load(std::memory_order_relaxed) == 0) {
+    return false;
+  }
+
+  header->frozen.store(true, std::memory_order_release);
+
+  return true;
+}
+
+auto is_frozen(const void* block) noexcept -> bool {
+  if (!block) {
+    return false;
+  }
+
+  auto header = memory::header_of(const_cast<void*>(block));
+
+  return header->frozen.load(std::memory_order_acquire);
+}
+
+auto malloc_purgeable(std::size_t size, memory::purge_callback callback,
+                      void* context) noexcept -> void* {
+  auto result = malloc(size);
+
+  if (!result) {
+    return nullptr;
+  }
+
+  auto header = memory::header_of(result);
+
+  try {
+    memory::internal::default_purgeable.add(header, callback, context);
   } catch (std::bad_alloc&) {
+    free(result);
+
     return nullptr;
   }
+
+  header->purgeable = true;
+
+  return result;
 }
 
-auto free(void* block) -> void {
+auto pin(void* block) noexcept -> bool {
   if (!block) {
+    return false;
+  }
+
+  // Looked up by address only, the header of a purged block may be reused
+  return memory::internal::default_purgeable.pin(memory::header_of(block));
+}
+
+auto unpin(void* block) noexcept -> bool {
+  if (!block) {
+    return false;
+  }
+
+  try {
+    return memory::internal::default_purgeable.unpin(memory::header_of(block));
+  } catch (std::bad_alloc&) {
+    return false;
+  }
+}
+
+auto try_expand(void* block, std::size_t size) noexcept -> bool {
+  if (!block || !memory::internal::default_allocator) {
+    return false;
+  }
+
+  auto header = memory::header_of(block);
+
+  if (header->frozen.load(std::memory_order_acquire)) {
+    return false;
+  }
+
+  return memory::internal::default_allocator->try_expand_block(header, size);
+}
+
+auto trim() noexcept -> void {
+  if (!memory::internal::default_allocator) {
     return;
   }
 
+  free_deferred();
+
+  memory::internal::default_allocator->trim();
+}
+
+auto set_decay(std::chrono::milliseconds decay) noexcept -> void {
+  memory::internal::default_decay = decay;
+
+  if (memory::internal::default_allocator) {
+    memory::internal::default_allocator->purger().set_decay(decay);
+  }
+}
+
+auto stats() noexcept -> memory::allocator_stats {
   if (!memory::internal::default_allocator) {
-    set_heap(S21_MEMORY_DEFAULT_HEAP_SIZE);
+    return {};
+  }
+
+  return memory::internal::default_allocator->stats();
+}
+
+auto size_classes() -> std::vector<std::size_t> {
+  return memory::internal::default_size_classes.table();
+}
+
+auto set_size_classes(const std::vector<std::size_t>& table) -> bool {
+  auto& classes = memory::internal::default_size_classes;
+
+  if (!classes.set_table(table)) {
+    return false;
   }
 
-  memory::internal::default_allocator->free_block(memory::header_of(block));
+  if (memory::internal::default_allocator) {
+    memory::internal::default_allocator->set_split_threshold(
+        classes.split_threshold());
+  }
+
+  return true;
+}
+
+auto size_class_stats() noexcept -> memory::size_class_stats {
+  return memory::internal::default_size_classes.stats();
+}
+
+auto block_of(const void* pointer) noexcept -> void* {
+  if (!pointer || !memory::internal::default_allocator) {
+    return nullptr;
+  }
+
+  auto block = memory::internal::default_allocator->block_of(pointer);
+
+  if (!block) {
+    return nullptr;
+  }
+
+  return memory::data_of(block);
 }
 
 }  // namespace s21
 
-auto s21_malloc(size_t size) -> void* { return s21::malloc(size); }
+auto s21_malloc(size_t size) noexcept -> void* { return s21::malloc(size); }
+
+auto s21_malloc_hint(size_t size, s21_lifetime lifetime) noexcept -> void* {
+  if (lifetime < S21_LIFETIME_SHORT || lifetime >= S21_LIFETIME_COUNT) {
+    return nullptr;
+  }
 
-auto s21_calloc(size_t n, size_t size) -> void* { return s21::calloc(n, size); }
+  return s21::malloc_hint(size,
+                          static_cast<s21::memory::block_lifetime>(lifetime));
+}
+
+auto s21_calloc(size_t n, size_t size) noexcept -> void* {
+  return s21::calloc(n, size);
+}
 
-auto s21_realloc(void* block, size_t size) -> void* {
+auto s21_realloc(void* block, size_t size) noexcept -> void* {
   return s21::realloc(block, size);
 }
 
-auto s21_free(void* block) -> void { return s21::free(block); }
+auto s21_free(void* block) noexcept -> void { return s21::free(block); }
+
+auto s21_malloc_shared(size_t size) noexcept -> void* {
+  return s21::malloc_shared(size);
+}
+
+auto s21_retain(void* block) noexcept -> void* { return s21::retain(block); }
+
+auto s21_release(void* block) noexcept -> void { s21::release(block); }
+
+auto s21_freeze(void* block) noexcept -> int { return s21::freeze(block); }
+
+auto s21_is_frozen(const void* block) noexcept -> int {
+  return s21::is_frozen(block);
+}
+
+auto s21_malloc_purgeable(size_t size, s21_purge_callback callback,
+                          void* context) noexcept -> void* {
+  return s21::malloc_purgeable(size, callback, context);
+}
+
+auto s21_pin(void* block) noexcept -> int { return s21::pin(block); }
+
+auto s21_unpin(void* block) noexcept -> int { return s21::unpin(block); }
+
+auto s21_try_expand(void* block, size_t size) noexcept -> int {
+  return s21::try_expand(block, size);
+}
+
+auto s21_trim() noexcept -> void { s21::trim(); }
+
+auto s21_set_decay(size_t milliseconds) noexcept -> void {
+  s21::set_decay(std::chrono::milliseconds(milliseconds));
+}
+
+auto s21_stats(s21_memory_stats* stats) noexcept -> void {
+  if (!stats) {
+    return;
+  }
+
+  auto result = s21::stats();
+
+  stats->committed = result.committed;
+  stats->resident = result.resident;
+
+  for (auto i = 0; i < S21_LIFETIME_COUNT; i++) {
+    stats->lifetimes[i].blocks = result.lifetimes[i].blocks;
+    stats->lifetimes[i].bytes = result.lifetimes[i].bytes;
+    stats->lifetimes[i].span = result.lifetimes[i].span;
+  }
+}
+
+auto s21_export_size_classes(size_t* table, size_t capacity) noexcept
+    -> size_t {
+  auto& result = s21::memory::internal::default_size_classes.table();
+
+  for (auto i = std::size_t(0); table && i < capacity && i < result.size();
+       i++) {
+    table[i] = result[i];
+  }
+
+  return result.size();
+}
+
+auto s21_import_size_classes(const size_t* table, size_t count) noexcept
+    -> int {
+  if (!table && count != 0) {
+    return false;
+  }
+
+  try {
+    auto imported = std::vector<std::size_t>(table, table + count);
+
+    return s21::set_size_classes(imported);
+  } catch (std::bad_alloc&) {
+    return false;
+  }
+}
+
+auto s21_size_class_report(s21_size_class_stats* stats) noexcept -> void {
+  if (!stats) {
+    return;
+  }
+
+  auto result = s21::size_class_stats();
+
+  stats->retunes = result.retunes;
+  stats->requested = result.requested;
+  stats->before = result.before;
+  stats->after = result.after;
+}
+
+auto s21_block_of(const void* pointer) noexcept -> void* {
+  return s21::block_of(pointer);
+}
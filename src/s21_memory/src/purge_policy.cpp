@@ -0,0 +1,142 @@
+#include "s21_memory/purge_policy.hpp"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "s21_memory/block.hpp"
+
+#if defined(S21_MEMORY_USE_MADV_FREE) && defined(MADV_FREE)
+#define S21_MEMORY_PURGE_ADVICE MADV_FREE
+#else
+#define S21_MEMORY_PURGE_ADVICE MADV_DONTNEED
+#endif
+
+namespace s21::memory {
+
+decay_purge::decay_purge(clock::duration decay)
+    : decay_(decay), last_tick_(clock::now()) {}
+
+auto decay_purge::attach(raw_ptr data, std::size_t size) -> void {
+  page_size_ = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+
+  auto address = reinterpret_cast<std::uintptr_t>(data);
+  auto base = address - address % page_size_;
+
+  base_ = reinterpret_cast<raw_ptr>(base);
+
+  auto span = address + size - base;
+
+  pages_.assign((span + page_size_ - 1) / page_size_, page_state::resident);
+  purged_pages_ = 0;
+}
+
+auto decay_purge::set_decay(clock::duration decay) -> void { decay_ = decay; }
+
+auto decay_purge::on_commit(raw_ptr begin, raw_ptr end) -> void {
+  if (pages_.empty()) {
+    return;
+  }
+
+  auto first = static_cast<std::size_t>(begin - base_) / page_size_;
+  auto last = (static_cast<std::size_t>(end - base_) + page_size_ - 1) /
+              page_size_;
+
+  for (auto page = first; page < last && page < pages_.size(); page++) {
+    if (pages_[page] == page_state::purged) {
+      purged_pages_--;
+    }
+
+    pages_[page] = page_state::resident;
+  }
+}
+
+auto decay_purge::should_tick() -> bool {
+  if (++operations_ < clock_interval && decay_ != clock::duration::zero()) {
+    return false;
+  }
+
+  operations_ = 0;
+
+  auto now = clock::now();
+
+  if (now - last_tick_ < decay_) {
+    return false;
+  }
+
+  last_tick_ = now;
+
+  return true;
+}
+
+auto decay_purge::tick(block_header* root, bool force) -> void {
+  if (pages_.empty()) {
+    return;
+  }
+
+  for (auto block = root; block; block = block->next) {
+    if (block->type != block_type::free) {
+      continue;
+    }
+
+    auto begin = static_cast<std::size_t>(data_of(block) - base_);
+    auto end = begin + block->size;
+
+    auto first = (begin + page_size_ - 1) / page_size_;
+    auto last = end / page_size_;
+
+    auto run = first;
+
+    for (auto page = first; page < last; page++) {
+      if (force || pages_[page] == page_state::idle) {
+        continue;
+      }
+
+      purge_pages(run, page);
+
+      if (pages_[page] == page_state::resident) {
+        pages_[page] = page_state::idle;
+      }
+
+      run = page + 1;
+    }
+
+    purge_pages(run, last);
+  }
+}
+
+auto decay_purge::purge_pages(std::size_t first, std::size_t last) -> void {
+  while (first < last && pages_[first] == page_state::purged) {
+    first++;
+  }
+
+  while (last > first && pages_[last - 1] == page_state::purged) {
+    last--;
+  }
+
+  if (first >= last) {
+    return;
+  }
+
+  auto address = base_ + first * page_size_;
+  auto length = (last - first) * page_size_;
+
+  if (madvise(address, length, S21_MEMORY_PURGE_ADVICE) != 0) {
+    return;
+  }
+
+  for (auto page = first; page < last; page++) {
+    if (pages_[page] != page_state::purged) {
+      pages_[page] = page_state::purged;
+      purged_pages_++;
+    }
+  }
+}
+
+auto decay_purge::purged() const -> std::size_t {
+  return purged_pages_ * page_size_;
+}
+
+}  // namespace s21::memory
@@ -0,0 +1,92 @@
+#include "s21_memory/purgeable.hpp"
+
+#include <cstddef>
+#include <optional>
+
+#include "s21_memory/block.hpp"
+
+namespace s21::memory {
+
+auto purgeable_blocks::add(block_header* block, purge_callback callback,
+                           void* context) -> void {
+  entries_[block] = {1, callback, context, lru_.end()};
+}
+
+auto purgeable_blocks::remove(block_header* block) -> void {
+  auto found = entries_.find(block);
+
+  if (found == entries_.end()) {
+    return;
+  }
+
+  if (found->second.pins == 0) {
+    lru_.erase(found->second.position);
+  }
+
+  entries_.erase(found);
+}
+
+auto purgeable_blocks::pin(block_header* block) -> bool {
+  auto found = entries_.find(block);
+
+  if (found == entries_.end()) {
+    return false;
+  }
+
+  auto& entry = found->second;
+
+  if (entry.pins++ == 0) {
+    lru_.erase(entry.position);
+    entry.position = lru_.end();
+  }
+
+  return true;
+}
+
+auto purgeable_blocks::unpin(block_header* block) -> bool {
+  auto found = entries_.find(block);
+
+  if (found == entries_.end() || found->second.pins == 0) {
+    return false;
+  }
+
+  auto& entry = found->second;
+
+  // Inserts before unpinning, so the entry stays pinned if insert throws
+  if (entry.pins == 1) {
+    entry.position = lru_.insert(lru_.end(), block);
+  }
+
+  entry.pins--;
+
+  return true;
+}
+
+auto purgeable_blocks::evict() -> std::optional<purged_block> {
+  if (lru_.empty()) {
+    return std::nullopt;
+  }
+
+  auto block = lru_.front();
+  auto found = entries_.find(block);
+  auto result = purged_block{block, found->second.callback,
+                             found->second.context};
+
+  lru_.pop_front();
+  entries_.erase(found);
+
+  purged_++;
+
+  return result;
+}
+
+auto purgeable_blocks::clear() -> void {
+  entries_.clear();
+  lru_.clear();
+}
+
+auto purgeable_blocks::size() const -> std::size_t { return entries_.size(); }
+
+auto purgeable_blocks::purged() const -> std::size_t { return purged_; }
+
+}  // namespace s21::memory
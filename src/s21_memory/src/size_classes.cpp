@@ -0,0 +1,189 @@
+#include "s21_memory/size_classes.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "s21_memory/block.hpp"
+
+namespace s21::memory {
+
+namespace {
+
+auto round_to(const std::vector<std::size_t>& table, std::size_t size) {
+  auto aligned = align_of(size);
+
+  if (aligned == 0) {
+    return aligned;
+  }
+
+  for (auto size_class : table) {
+    if (aligned <= size_class) {
+      return size_class;
+    }
+  }
+
+  return aligned;
+}
+
+}  // namespace
+
+size_classes::size_classes(std::size_t interval) : interval_(interval) {
+  table_.reserve(max_classes);
+}
+
+auto size_classes::record(std::size_t size) -> bool {
+  auto aligned = align_of(size);
+
+  if (aligned == 0 || aligned > max_size) {
+    return false;
+  }
+
+  histogram_[aligned / word_size - 1]++;
+
+  if (interval_ == 0 || ++recorded_ < interval_) {
+    return false;
+  }
+
+  recorded_ = 0;
+
+  retune();
+
+  return true;
+}
+
+auto size_classes::round(std::size_t size) const -> std::size_t {
+  return round_to(table_, size);
+}
+
+auto size_classes::retune() -> void {
+  // Buffers are bounded by the number of bins, so retune never allocates
+  auto sizes = std::array<std::size_t, bins>();
+  auto bin_count = std::size_t(0);
+
+  // Prefix sums of request counts and requested bytes over non-empty bins
+  auto counts = std::array<std::uint64_t, bins + 1>();
+  auto bytes = std::array<std::uint64_t, bins + 1>();
+
+  for (auto bin = std::size_t(0); bin < bins; bin++) {
+    if (histogram_[bin] == 0) {
+      continue;
+    }
+
+    auto size = (bin + 1) * word_size;
+
+    sizes[bin_count] = size;
+    counts[bin_count + 1] = counts[bin_count] + histogram_[bin];
+    bytes[bin_count + 1] = bytes[bin_count] + histogram_[bin] * size;
+
+    bin_count++;
+  }
+
+  if (bin_count == 0) {
+    return;
+  }
+
+  // Waste of rounding the requests of bins [first, last] up to bin `last`
+  auto waste = [&](std::size_t first, std::size_t last) {
+    return sizes[last] * (counts[last + 1] - counts[first]) -
+           (bytes[last + 1] - bytes[first]);
+  };
+
+  auto class_count = std::min(max_classes, bin_count);
+
+  // cost[n][last] is the least waste of covering bins [0, last] with n + 1
+  // classes, the largest of which is bin `last`
+  auto cost = std::array<std::array<std::uint64_t, bins>, max_classes>();
+  auto previous = std::array<std::array<std::size_t, bins>, max_classes>();
+
+  for (auto& row : cost) {
+    row.fill(std::numeric_limits<std::uint64_t>::max());
+  }
+
+  for (auto last = std::size_t(0); last < bin_count; last++) {
+    cost[0][last] = waste(0, last);
+  }
+
+  for (auto n = std::size_t(1); n < class_count; n++) {
+    for (auto last = n; last < bin_count; last++) {
+      for (auto split = n - 1; split < last; split++) {
+        auto candidate = cost[n - 1][split] + waste(split + 1, last);
+
+        if (candidate < cost[n][last]) {
+          cost[n][last] = candidate;
+          previous[n][last] = split;
+        }
+      }
+    }
+  }
+
+  auto table = std::array<std::size_t, max_classes>();
+
+  for (auto n = class_count, last = bin_count - 1; n-- > 0;) {
+    table[n] = sizes[last];
+    last = previous[n][last];
+  }
+
+  stats_.retunes++;
+  stats_.requested = bytes[bin_count];
+  stats_.before = rounded_size(table_);
+
+  // Fits into the capacity reserved by the constructor
+  table_.assign(table.begin(), table.begin() + class_count);
+
+  stats_.after = rounded_size(table_);
+
+  for (auto& count : histogram_) {
+    count /= 2;
+  }
+}
+
+auto size_classes::split_threshold() const -> std::size_t {
+  if (table_.empty()) {
+    return 0;
+  }
+
+  return table_.front() - word_size;
+}
+
+auto size_classes::table() const -> const std::vector<std::size_t>& {
+  return table_;
+}
+
+auto size_classes::set_table(const std::vector<std::size_t>& table) -> bool {
+  if (table.size() > max_classes) {
+    return false;
+  }
+
+  for (auto i = std::size_t(0); i < table.size(); i++) {
+    if (table[i] == 0 || table[i] > max_size || table[i] % word_size != 0) {
+      return false;
+    }
+
+    if (i > 0 && table[i] <= table[i - 1]) {
+      return false;
+    }
+  }
+
+  table_.assign(table.begin(), table.end());
+
+  return true;
+}
+
+auto size_classes::stats() const -> size_class_stats { return stats_; }
+
+auto size_classes::rounded_size(const std::vector<std::size_t>& table) const
+    -> std::size_t {
+  auto result = std::size_t(0);
+
+  for (auto bin = std::size_t(0); bin < bins; bin++) {
+    result += histogram_[bin] * round_to(table, (bin + 1) * word_size);
+  }
+
+  return result;
+}
+
+}  // namespace s21::memory
@@ -4,9 +4,15 @@
 #include <gtest/gtest.h>
 
 #include <array>
+#include <cstring>
 #include <new>
+#include <system_error>
+#include <thread>
+#include <vector>
 
 #include "s21_memory/block.hpp"
+#include "s21_memory/fit_policy.hpp"
+#include "s21_memory/lock_policy.hpp"
 
 using namespace testing;
 
@@ -57,6 +63,80 @@ TEST(allocator_allocate_block, should_set_block_type) {
   }
 }
 
+TEST(allocator_try_allocate_block, should_return_nullptr_if_out_of_memory) {
+  auto allocator = s21::memory::allocator(0);
+
+  static_assert(noexcept(allocator.try_allocate_block(1)));
+
+  EXPECT_EQ(allocator.try_allocate_block(1), nullptr);
+}
+
+TEST(allocator_try_allocate_block, should_allocate_block) {
+  auto allocator = s21::memory::allocator(64);
+
+  auto block = allocator.try_allocate_block(16, s21::memory::block_type::int_t);
+
+  ASSERT_NE(block, nullptr);
+  EXPECT_EQ(block->size, 16);
+  EXPECT_EQ(block->type, s21::memory::block_type::int_t);
+}
+
+TEST(allocator_try_reallocate_block,
+     should_return_nullptr_and_keep_block_if_out_of_memory) {
+  auto allocator = s21::memory::allocator(64);
+
+  static_assert(noexcept(allocator.try_reallocate_block(nullptr, 0)));
+
+  auto block = allocator.allocate_block(16);
+  auto block_copy = *block;
+
+  EXPECT_EQ(allocator.try_reallocate_block(block, 1024), nullptr);
+  EXPECT_EQ(block->size, block_copy.size);
+  EXPECT_EQ(block->type, block_copy.type);
+}
+
+/**
+ * @brief Lock policy which fails like std::mutex reporting a system error
+ */
+class failing_lock {
+ public:
+  auto lock() -> void {
+    if (fail) {
+      throw std::system_error(
+          std::make_error_code(std::errc::resource_deadlock_would_occur));
+    }
+  }
+
+  auto unlock() -> void {}
+
+  static inline bool fail = false;
+};
+
+TEST(allocator_try_allocate_block, should_fail_without_throwing_if_lock_fails) {
+  auto allocator =
+      s21::memory::basic_allocator<s21::memory::default_fit, failing_lock>(64);
+
+  auto block = allocator.allocate_block(16);
+
+  failing_lock::fail = true;
+
+  EXPECT_EQ(allocator.try_allocate_block(16), nullptr);
+  EXPECT_EQ(allocator.try_reallocate_block(block, 32), nullptr);
+  EXPECT_FALSE(allocator.try_expand_block(block, 32));
+  EXPECT_EQ(block->size, 16);
+
+  failing_lock::fail = false;
+}
+
+TEST(allocator_reallocate_block, should_throw_bad_alloc_if_out_of_memory) {
+  auto allocator = s21::memory::allocator(64);
+
+  auto block = allocator.allocate_block(16);
+
+  EXPECT_THROW(allocator.reallocate_block(block, 1024), std::bad_alloc);
+  EXPECT_EQ(block->type, s21::memory::block_type::char_t);
+}
+
 TEST(allocator_free_block, should_set_block_type_to_free) {
   auto allocator = s21::memory::allocator(0);
 
@@ -217,6 +297,138 @@ TEST(
   EXPECT_EQ(block->type, s21::memory::block_type::free);
 }
 
+TEST(allocator_reallocate_block,
+     should_grow_into_previous_free_block_and_preserve_data) {
+  auto allocator = s21::memory::allocator(256);
+
+  auto previous = allocator.allocate_block(32);
+  auto block = allocator.allocate_block(8);
+  allocator.allocate_block(0);
+
+  std::memcpy(s21::memory::data_of(block), "1234567", 8);
+
+  allocator.free_block(previous);
+
+  auto reallocated_block = allocator.reallocate_block(block, 32);
+
+  EXPECT_EQ(reallocated_block, previous);
+  EXPECT_EQ(reallocated_block->size, 32);
+  EXPECT_EQ(reallocated_block->type, s21::memory::block_type::char_t);
+  EXPECT_STREQ(
+      reinterpret_cast<char*>(s21::memory::data_of(reallocated_block)),
+      "1234567");
+}
+
+TEST(allocator_reallocate_block, should_grow_over_several_free_blocks) {
+  auto allocator = s21::memory::allocator(256);
+
+  auto block = allocator.allocate_block(8);
+  auto next1 = allocator.allocate_block(8);
+  auto next2 = allocator.allocate_block(8);
+  allocator.allocate_block(0);
+
+  allocator.free_block(next1);
+  allocator.free_block(next2);
+
+  auto new_size = 8 + 2 * s21::memory::block_size_of(8);
+
+  auto reallocated_block = allocator.reallocate_block(block, new_size);
+
+  EXPECT_EQ(reallocated_block, block);
+  EXPECT_EQ(reallocated_block->size, new_size);
+}
+
+TEST(allocator_reallocate_block, should_grow_in_place_on_repeated_growth) {
+  auto allocator = s21::memory::allocator(1024);
+
+  auto block = allocator.allocate_block(8);
+
+  for (auto size = 16ul; size <= 512; size *= 2) {
+    auto reallocated_block = allocator.reallocate_block(block, size);
+
+    EXPECT_EQ(reallocated_block, block);
+    EXPECT_EQ(reallocated_block->size, size);
+  }
+}
+
+TEST(allocator_try_expand_block, should_expand_into_next_free_block) {
+  auto allocator = s21::memory::allocator(256);
+
+  auto block = allocator.allocate_block(8);
+
+  EXPECT_TRUE(allocator.try_expand_block(block, 64));
+  EXPECT_EQ(block->size, 64);
+}
+
+TEST(allocator_try_expand_block, should_not_move_block) {
+  auto allocator = s21::memory::allocator(256);
+
+  auto previous = allocator.allocate_block(64);
+  auto block = allocator.allocate_block(8);
+  auto next = allocator.allocate_block(0);
+
+  allocator.free_block(previous);
+
+  EXPECT_FALSE(allocator.try_expand_block(block, 32));
+  EXPECT_EQ(block->size, 8);
+  EXPECT_EQ(block->next, next);
+  EXPECT_EQ(previous->type, s21::memory::block_type::free);
+}
+
+TEST(allocator_try_expand_block, should_succeed_if_block_is_large_enough) {
+  auto allocator = s21::memory::allocator(256);
+
+  auto block = allocator.allocate_block(16);
+
+  EXPECT_TRUE(allocator.try_expand_block(block, 10));
+  EXPECT_EQ(block->size, 16);
+}
+
+TEST(allocator_blocks, should_link_previous_blocks) {
+  auto allocator = s21::memory::allocator(256);
+
+  allocator.allocate_block(8);
+  allocator.allocate_block(8);
+
+  auto blocks = allocator.blocks();
+
+  EXPECT_EQ(blocks.front()->prev, nullptr);
+
+  for (auto i = 1ul; i < blocks.size(); i++) {
+    EXPECT_EQ(blocks[i]->prev, blocks[i - 1]);
+  }
+}
+
+TEST(allocator_trim, should_return_free_pages_to_the_os) {
+  auto allocator = s21::memory::allocator(1024 * 1024);
+
+  allocator.free_block(allocator.allocate_block(512 * 1024));
+
+  allocator.trim();
+
+  auto stats = allocator.stats();
+
+  EXPECT_LT(stats.resident, stats.committed);
+  EXPECT_LE(stats.committed - stats.resident, allocator.size());
+}
+
+TEST(allocator_trim, should_recommit_pages_on_reuse) {
+  auto allocator = s21::memory::allocator(1024 * 1024);
+
+  allocator.free_block(allocator.allocate_block(512 * 1024));
+
+  allocator.trim();
+
+  auto block = allocator.allocate_block(1024 * 1024);
+
+  std::memset(s21::memory::data_of(block), 0x2a, block->size);
+
+  auto stats = allocator.stats();
+
+  EXPECT_EQ(stats.resident, stats.committed);
+  EXPECT_EQ(s21::memory::data_of(block)[block->size - 1], 0x2a);
+}
+
 TEST(allocator_blocks, should_return_block_vector) {
   auto allocator = s21::memory::allocator(256);
 
@@ -236,3 +448,138 @@ TEST(allocator_blocks, should_return_block_vector) {
     EXPECT_EQ(blocks[i], result[i]);
   }
 }
+
+/*
+ * Behaviour shared by all lock policies
+ */
+
+template <typename Allocator>
+class locked_allocator : public Test {};
+
+using locked_allocators = Types<
+    s21::memory::basic_allocator<s21::memory::first_fit,
+                                 s21::memory::mutex_lock>,
+    s21::memory::basic_allocator<s21::memory::best_fit,
+                                 s21::memory::spin_lock>>;
+
+TYPED_TEST_SUITE(locked_allocator, locked_allocators);
+
+TYPED_TEST(locked_allocator, should_be_thread_safe) {
+  auto allocator = TypeParam(64 * 1024);
+
+  auto work = [&allocator] {
+    for (auto i = 0; i < 1000; i++) {
+      auto block = allocator.allocate_block(16);
+      allocator.free_block(block);
+    }
+  };
+
+  auto threads = std::vector<std::thread>();
+
+  for (auto i = 0; i < 4; i++) {
+    threads.emplace_back(work);
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  allocator.merge_free_blocks();
+
+  EXPECT_EQ(allocator.blocks().size(), 1);
+}
+
+TEST(allocator_allocate_block,
+     should_place_long_lived_blocks_from_the_end_of_the_heap) {
+  auto allocator = s21::memory::allocator(256);
+
+  auto short_lived = allocator.allocate_block(16);
+  auto long_lived = allocator.allocate_block(
+      16, s21::memory::block_type::char_t,
+      s21::memory::block_lifetime::long_lived);
+
+  auto blocks = allocator.blocks();
+
+  EXPECT_EQ(blocks.front(), short_lived);
+  EXPECT_EQ(blocks.back(), long_lived);
+  EXPECT_EQ(long_lived->size, 16);
+  EXPECT_EQ(long_lived->lifetime, s21::memory::block_lifetime::long_lived);
+}
+
+TEST(allocator_allocate_block, should_not_pin_holes_between_short_lived) {
+  auto allocator = s21::memory::allocator(512);
+
+  auto first = allocator.allocate_block(32);
+
+  allocator.allocate_block(32, s21::memory::block_type::char_t,
+                           s21::memory::block_lifetime::permanent);
+
+  auto second = allocator.allocate_block(32);
+
+  allocator.free_block(first);
+  allocator.free_block(second);
+
+  auto block = allocator.allocate_block(64 + s21::memory::block_size_of(0));
+
+  EXPECT_EQ(block, first);
+}
+
+TEST(allocator_stats, should_report_lifetime_placement) {
+  auto allocator = s21::memory::allocator(512);
+
+  allocator.allocate_block(16);
+  allocator.allocate_block(16);
+  allocator.allocate_block(16, s21::memory::block_type::char_t,
+                           s21::memory::block_lifetime::long_lived);
+
+  auto stats = allocator.stats();
+
+  auto& short_lived = stats.lifetimes[0];
+  auto& long_lived = stats.lifetimes[1];
+  auto& permanent = stats.lifetimes[2];
+
+  EXPECT_EQ(short_lived.blocks, 2);
+  EXPECT_EQ(short_lived.bytes, 2 * s21::memory::block_size_of(16));
+  EXPECT_EQ(short_lived.span, short_lived.bytes);
+
+  EXPECT_EQ(long_lived.blocks, 1);
+  EXPECT_EQ(long_lived.span, long_lived.bytes);
+
+  EXPECT_EQ(permanent.blocks, 0);
+  EXPECT_EQ(permanent.span, 0);
+}
+
+TEST(allocator_reallocate_block, should_keep_lifetime_when_growing_backward) {
+  auto allocator = s21::memory::allocator(512);
+
+  auto block = allocator.allocate_block(
+      16, s21::memory::block_type::char_t,
+      s21::memory::block_lifetime::long_lived);
+
+  auto result = allocator.reallocate_block(block, 200);
+
+  EXPECT_LT(result, block);
+  EXPECT_EQ(result->lifetime, s21::memory::block_lifetime::long_lived);
+  EXPECT_EQ(allocator.stats().lifetimes[0].blocks, 0);
+  EXPECT_EQ(allocator.stats().lifetimes[1].blocks, 1);
+}
+
+TEST(allocator, should_not_split_remainder_below_threshold) {
+  auto allocator = s21::memory::allocator(512);
+
+  auto first = allocator.allocate_block(64);
+  allocator.allocate_block(0);
+
+  allocator.free_block(first);
+  allocator.set_split_threshold(32);
+
+  auto block = allocator.allocate_block(16);
+
+  EXPECT_EQ(block, first);
+  EXPECT_EQ(block->size, 64);
+
+  allocator.free_block(block);
+  allocator.set_split_threshold(0);
+
+  EXPECT_EQ(allocator.allocate_block(16)->size, 16);
+}
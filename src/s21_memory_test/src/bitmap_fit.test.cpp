@@ -0,0 +1,154 @@
+#include "s21_memory/bitmap_fit.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "s21_memory/allocator.hpp"
+#include "s21_memory/block.hpp"
+
+using namespace testing;
+
+using bitmap_allocator = s21::memory::basic_allocator<s21::memory::bitmap_fit>;
+
+TEST(bitmap_fit, should_return_first_suitable_block) {
+  auto allocator = bitmap_allocator(512);
+
+  auto large = allocator.allocate_block(64);
+  allocator.allocate_block(0);
+  auto small = allocator.allocate_block(16);
+  allocator.allocate_block(0);
+
+  allocator.free_block(large);
+  allocator.free_block(small);
+
+  auto block = allocator.allocate_block(16);
+
+  EXPECT_EQ(block, large);
+}
+
+TEST(bitmap_fit, should_join_adjacent_free_blocks) {
+  auto allocator = bitmap_allocator(512);
+
+  auto first = allocator.allocate_block(16);
+  auto second = allocator.allocate_block(16);
+  allocator.allocate_block(0);
+
+  allocator.free_block(first);
+  allocator.free_block(second);
+
+  auto block = allocator.allocate_block(32);
+
+  EXPECT_EQ(block, first);
+  EXPECT_EQ(allocator.blocks().size(), 3);
+}
+
+TEST(bitmap_fit, should_search_across_bitmap_words) {
+  auto allocator = bitmap_allocator(4096);
+
+  auto blocks = std::vector<s21::memory::block_header*>();
+
+  while (auto block = allocator.try_allocate_block(8)) {
+    blocks.push_back(block);
+  }
+
+  allocator.free_block(blocks[24]);
+  allocator.free_block(blocks[25]);
+  allocator.free_block(blocks[26]);
+
+  auto block = allocator.allocate_block(s21::memory::block_size_of(8) * 2 + 8);
+
+  EXPECT_EQ(block, blocks[24]);
+  EXPECT_EQ(allocator.try_allocate_block(8), nullptr);
+}
+
+TEST(bitmap_fit, should_find_run_spanning_fully_free_words) {
+  auto allocator = bitmap_allocator(4096);
+
+  auto first = allocator.allocate_block(8);
+  auto large = allocator.allocate_block(2048);
+
+  EXPECT_EQ(reinterpret_cast<s21::memory::raw_ptr>(large),
+            reinterpret_cast<s21::memory::raw_ptr>(first) +
+                s21::memory::block_size_of(8));
+  EXPECT_EQ(allocator.try_allocate_block(2048), nullptr);
+}
+
+TEST(bitmap_fit, should_fail_when_no_run_is_large_enough) {
+  auto allocator = bitmap_allocator(256);
+
+  auto first = allocator.allocate_block(64);
+  allocator.allocate_block(0);
+  allocator.allocate_block(256 - s21::memory::block_size_of(64) -
+                           s21::memory::block_size_of(0) * 2);
+
+  allocator.free_block(first);
+
+  EXPECT_EQ(allocator.try_allocate_block(72), nullptr);
+  EXPECT_EQ(allocator.try_allocate_block(64), first);
+}
+
+TEST(bitmap_fit, should_find_block_of_interior_pointer) {
+  auto allocator = bitmap_allocator(16 * 1024);
+
+  auto small = allocator.allocate_block(16);
+  auto large = allocator.allocate_block(12 * 1024);
+  auto last = allocator.allocate_block(16);
+
+  auto data = s21::memory::data_of(large);
+
+  EXPECT_EQ(allocator.block_of(s21::memory::data_of(small) + 8), small);
+  EXPECT_EQ(allocator.block_of(data), large);
+  EXPECT_EQ(allocator.block_of(data + 5000), large);
+  EXPECT_EQ(allocator.block_of(data + large->size - 1), large);
+  EXPECT_EQ(allocator.block_of(s21::memory::data_of(last)), last);
+}
+
+TEST(bitmap_fit, should_not_find_block_of_free_memory) {
+  auto allocator = bitmap_allocator(512);
+
+  auto block = allocator.allocate_block(64);
+  auto data = s21::memory::data_of(block);
+
+  allocator.free_block(block);
+
+  int outside;
+
+  EXPECT_EQ(allocator.block_of(data + 8), nullptr);
+  EXPECT_EQ(allocator.block_of(&outside), nullptr);
+}
+
+TEST(bitmap_fit, should_track_reallocated_blocks) {
+  auto allocator = bitmap_allocator(1024);
+
+  auto first = allocator.allocate_block(64);
+  auto second = allocator.allocate_block(64);
+  allocator.allocate_block(0);
+
+  allocator.free_block(first);
+
+  auto moved = allocator.reallocate_block(second, 128);
+
+  EXPECT_EQ(moved, first);
+  EXPECT_EQ(allocator.block_of(s21::memory::data_of(moved) + 120), moved);
+
+  auto shrunk = allocator.reallocate_block(moved, 16);
+
+  EXPECT_EQ(allocator.block_of(s21::memory::data_of(shrunk) + 8), shrunk);
+  EXPECT_EQ(allocator.block_of(s21::memory::data_of(shrunk) + 64), nullptr);
+  EXPECT_EQ(allocator.allocate_block(16), shrunk->next);
+}
+
+TEST(list_fit, should_find_block_of_interior_pointer) {
+  auto allocator = s21::memory::allocator(512);
+
+  auto block = allocator.allocate_block(64);
+  auto free = allocator.allocate_block(16);
+  allocator.allocate_block(0);
+
+  allocator.free_block(free);
+
+  EXPECT_EQ(allocator.block_of(s21::memory::data_of(block) + 63), block);
+  EXPECT_EQ(allocator.block_of(s21::memory::data_of(free)), nullptr);
+}
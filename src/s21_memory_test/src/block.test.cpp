@@ -62,3 +62,7 @@ TEST(data_of, should_add_header_size) {
   EXPECT_EQ(reinterpret_cast<s21::memory::raw_ptr>(result),
             reinterpret_cast<s21::memory::raw_ptr>(data));
 }
+
+TEST(block_header, should_keep_shared_state_within_four_words) {
+  EXPECT_EQ(sizeof(s21::memory::block_header), 4 * s21::memory::word_size);
+}
@@ -0,0 +1,214 @@
+#include "s21_memory/buddy_allocator.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <random>
+#include <vector>
+
+#include "s21_memory/allocator.hpp"
+#include "s21_memory/block.hpp"
+
+using namespace testing;
+
+constexpr auto min_block_size = s21::memory::buddy_allocator::min_block_size;
+
+TEST(buddy_allocator, should_round_blocks_to_power_of_two) {
+  auto allocator = s21::memory::buddy_allocator(4096);
+
+  auto small = allocator.allocate_block(1);
+  auto large = allocator.allocate_block(min_block_size * 2);
+
+  EXPECT_EQ(s21::memory::block_size_of(small->size), min_block_size);
+  EXPECT_EQ(s21::memory::block_size_of(large->size), min_block_size * 4);
+}
+
+TEST(buddy_allocator, should_place_buddies_next_to_each_other) {
+  auto allocator = s21::memory::buddy_allocator(4096);
+
+  auto first = allocator.allocate_block(0);
+  auto second = allocator.allocate_block(0);
+
+  EXPECT_EQ(reinterpret_cast<s21::memory::raw_ptr>(second) -
+                reinterpret_cast<s21::memory::raw_ptr>(first),
+            min_block_size);
+}
+
+TEST(buddy_allocator, should_merge_buddies_on_free) {
+  auto allocator = s21::memory::buddy_allocator(4096);
+
+  auto blocks = std::vector<s21::memory::block_header*>();
+
+  while (auto block = allocator.try_allocate_block(0)) {
+    blocks.push_back(block);
+  }
+
+  EXPECT_EQ(blocks.size(), 4096 / min_block_size);
+
+  std::shuffle(blocks.begin(), blocks.end(), std::mt19937(21));
+
+  for (auto block : blocks) {
+    allocator.free_block(block);
+  }
+
+  auto whole = 4096 - sizeof(s21::memory::block_header);
+
+  EXPECT_EQ(allocator.blocks().size(), 1);
+  EXPECT_NE(allocator.try_allocate_block(whole), nullptr);
+}
+
+TEST(buddy_allocator, should_cover_heap_with_decreasing_orders) {
+  auto allocator = s21::memory::buddy_allocator(min_block_size * 7);
+
+  auto blocks = allocator.blocks();
+
+  ASSERT_EQ(blocks.size(), 3);
+  EXPECT_EQ(s21::memory::block_size_of(blocks[0]->size), min_block_size * 4);
+  EXPECT_EQ(s21::memory::block_size_of(blocks[1]->size), min_block_size * 2);
+  EXPECT_EQ(s21::memory::block_size_of(blocks[2]->size), min_block_size);
+
+  EXPECT_THROW(allocator.allocate_block(min_block_size * 4), std::bad_alloc);
+}
+
+TEST(buddy_allocator, should_not_merge_across_top_level_blocks) {
+  auto allocator = s21::memory::buddy_allocator(min_block_size * 3);
+
+  auto first = allocator.allocate_block(min_block_size);
+  auto second = allocator.allocate_block(0);
+
+  allocator.free_block(first);
+  allocator.free_block(second);
+
+  EXPECT_EQ(allocator.blocks().size(), 2);
+}
+
+TEST(buddy_allocator, should_grow_in_place_into_free_buddy) {
+  auto allocator = s21::memory::buddy_allocator(4096);
+
+  auto block = allocator.allocate_block(0);
+
+  std::memcpy(s21::memory::data_of(block), "abc", 4);
+
+  auto result = allocator.reallocate_block(block, min_block_size * 3);
+
+  EXPECT_EQ(result, block);
+  EXPECT_EQ(s21::memory::block_size_of(block->size), min_block_size * 4);
+  EXPECT_STREQ(reinterpret_cast<char*>(s21::memory::data_of(result)), "abc");
+}
+
+TEST(buddy_allocator, should_move_block_if_buddy_is_allocated) {
+  auto allocator = s21::memory::buddy_allocator(4096);
+
+  auto block = allocator.allocate_block(0);
+  auto buddy = allocator.allocate_block(0);
+
+  std::memcpy(s21::memory::data_of(block), "abc", 4);
+
+  auto result = allocator.reallocate_block(block, min_block_size);
+
+  EXPECT_NE(result, block);
+  EXPECT_STREQ(reinterpret_cast<char*>(s21::memory::data_of(result)), "abc");
+
+  allocator.free_block(buddy);
+  allocator.free_block(result);
+
+  EXPECT_EQ(allocator.blocks().size(), 1);
+}
+
+TEST(buddy_allocator, should_free_upper_halves_on_shrink) {
+  auto allocator = s21::memory::buddy_allocator(4096);
+
+  auto block = allocator.allocate_block(min_block_size * 3);
+
+  allocator.reallocate_block(block, 1);
+
+  EXPECT_EQ(s21::memory::block_size_of(block->size), min_block_size);
+
+  auto next = allocator.allocate_block(min_block_size);
+
+  EXPECT_EQ(reinterpret_cast<s21::memory::raw_ptr>(next) -
+                reinterpret_cast<s21::memory::raw_ptr>(block),
+            min_block_size * 2);
+}
+
+/*
+ * Behaviour shared by all allocator engines
+ */
+
+template <typename Engine>
+class engine : public Test {};
+
+using engines = Types<s21::memory::allocator, s21::memory::buddy_allocator>;
+
+TYPED_TEST_SUITE(engine, engines);
+
+TYPED_TEST(engine, should_allocate_writable_blocks) {
+  auto allocator = TypeParam(4096);
+
+  auto first = allocator.allocate_block(100, s21::memory::block_type::int_t);
+  auto second = allocator.allocate_block(100);
+
+  std::memset(s21::memory::data_of(first), 1, 100);
+  std::memset(s21::memory::data_of(second), 2, 100);
+
+  EXPECT_GE(first->size, 100);
+  EXPECT_EQ(first->type, s21::memory::block_type::int_t);
+  EXPECT_EQ(s21::memory::data_of(first)[99], 1);
+}
+
+TYPED_TEST(engine, should_keep_content_on_reallocate) {
+  auto allocator = TypeParam(4096);
+
+  auto block = allocator.allocate_block(8);
+  allocator.allocate_block(8);
+
+  std::memcpy(s21::memory::data_of(block), "abcdefg", 8);
+
+  auto result = allocator.reallocate_block(block, 1000);
+
+  EXPECT_GE(result->size, 1000);
+  EXPECT_STREQ(reinterpret_cast<char*>(s21::memory::data_of(result)),
+               "abcdefg");
+}
+
+TYPED_TEST(engine, should_free_block_on_reallocate_to_zero) {
+  auto allocator = TypeParam(4096);
+
+  auto block = allocator.allocate_block(8);
+
+  EXPECT_EQ(allocator.reallocate_block(block, 0), nullptr);
+  EXPECT_EQ(allocator.try_reallocate_block(nullptr, 8), nullptr);
+}
+
+TYPED_TEST(engine, should_throw_bad_alloc_if_out_of_memory) {
+  auto allocator = TypeParam(4096);
+
+  auto block = allocator.allocate_block(8);
+
+  EXPECT_THROW(allocator.allocate_block(8192), std::bad_alloc);
+  EXPECT_THROW(allocator.reallocate_block(block, 8192), std::bad_alloc);
+  EXPECT_EQ(allocator.try_allocate_block(8192), nullptr);
+}
+
+TYPED_TEST(engine, should_reuse_freed_memory) {
+  auto allocator = TypeParam(4096);
+
+  auto blocks = std::vector<s21::memory::block_header*>();
+
+  while (auto block = allocator.try_allocate_block(10)) {
+    blocks.push_back(block);
+  }
+
+  for (auto i = 0ul; i < blocks.size(); i += 2) {
+    allocator.free_block(blocks[i]);
+  }
+
+  for (auto i = 0ul; i < blocks.size(); i += 2) {
+    EXPECT_NE(allocator.try_allocate_block(10), nullptr);
+  }
+
+  EXPECT_EQ(allocator.try_allocate_block(10), nullptr);
+}
@@ -0,0 +1,154 @@
+#include "s21_memory/fit_policy.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <utility>
+
+#include "s21_memory/allocator.hpp"
+#include "s21_memory/block.hpp"
+
+using namespace testing;
+
+template <typename FitPolicy>
+auto make_holes(s21::memory::basic_allocator<FitPolicy>& allocator) {
+  auto large = allocator.allocate_block(64);
+  allocator.allocate_block(0);
+  auto small = allocator.allocate_block(16);
+  allocator.allocate_block(0);
+
+  allocator.free_block(large);
+  allocator.free_block(small);
+
+  return std::pair(large, small);
+}
+
+/**
+ * @brief Makes a hole too small to be split by a 16 byte request followed by
+ * an exact fit
+ */
+template <typename FitPolicy>
+auto make_near_fit_holes(s21::memory::basic_allocator<FitPolicy>& allocator) {
+  auto near = allocator.allocate_block(24);
+  allocator.allocate_block(0);
+  auto exact = allocator.allocate_block(16);
+  allocator.allocate_block(0);
+
+  allocator.free_block(near);
+  allocator.free_block(exact);
+
+  return std::pair(near, exact);
+}
+
+TEST(first_fit, should_return_first_suitable_block) {
+  auto allocator = s21::memory::basic_allocator<s21::memory::first_fit>(512);
+
+  auto [large, small] = make_holes(allocator);
+
+  auto block = allocator.allocate_block(16);
+
+  EXPECT_EQ(block, large);
+}
+
+TEST(best_fit, should_return_smallest_suitable_block) {
+  auto allocator = s21::memory::basic_allocator<s21::memory::best_fit>(512);
+
+  auto [large, small] = make_holes(allocator);
+
+  auto block = allocator.allocate_block(16);
+
+  EXPECT_EQ(block, small);
+}
+
+TEST(address_ordered_best_fit, should_return_smallest_suitable_block) {
+  auto allocator =
+      s21::memory::basic_allocator<s21::memory::address_ordered_best_fit>(512);
+
+  auto [large, small] = make_holes(allocator);
+
+  auto block = allocator.allocate_block(16);
+
+  EXPECT_EQ(block, small);
+}
+
+TEST(best_fit, should_stop_at_block_too_small_to_split) {
+  auto allocator = s21::memory::basic_allocator<s21::memory::best_fit>(512);
+
+  auto [near, exact] = make_near_fit_holes(allocator);
+
+  auto block = allocator.allocate_block(16);
+
+  EXPECT_EQ(block, near);
+}
+
+TEST(address_ordered_best_fit, should_prefer_exact_fit_over_earlier_block) {
+  auto allocator =
+      s21::memory::basic_allocator<s21::memory::address_ordered_best_fit>(512);
+
+  auto [near, exact] = make_near_fit_holes(allocator);
+
+  auto block = allocator.allocate_block(16);
+
+  EXPECT_EQ(block, exact);
+}
+
+TEST(address_ordered_best_fit, should_prefer_lower_address_on_tie) {
+  auto allocator =
+      s21::memory::basic_allocator<s21::memory::address_ordered_best_fit>(512);
+
+  auto first = allocator.allocate_block(16);
+  allocator.allocate_block(0);
+  auto second = allocator.allocate_block(16);
+  allocator.allocate_block(0);
+
+  allocator.free_block(second);
+  allocator.free_block(first);
+
+  auto block = allocator.allocate_block(16);
+
+  EXPECT_EQ(block, first);
+}
+
+TEST(next_fit, should_continue_search_from_last_allocated_block) {
+  auto allocator = s21::memory::basic_allocator<s21::memory::next_fit>(512);
+
+  auto first = allocator.allocate_block(16);
+  auto second = allocator.allocate_block(16);
+
+  allocator.free_block(first);
+
+  auto block = allocator.allocate_block(16);
+
+  EXPECT_NE(block, first);
+  EXPECT_GT(block, second);
+}
+
+TEST(next_fit, should_wrap_around_to_heap_start) {
+  auto allocator = s21::memory::basic_allocator<s21::memory::next_fit>(
+      s21::memory::block_size_of(16) + 16);
+
+  auto first = allocator.allocate_block(16);
+  allocator.allocate_block(16);
+
+  allocator.free_block(first);
+
+  auto block = allocator.allocate_block(16);
+
+  EXPECT_EQ(block, first);
+}
+
+TEST(next_fit, should_survive_merge_of_roving_block) {
+  auto allocator = s21::memory::basic_allocator<s21::memory::next_fit>(512);
+
+  auto first = allocator.allocate_block(16);
+  auto second = allocator.allocate_block(16);
+
+  allocator.free_block(first);
+  allocator.free_block(second);
+
+  allocator.merge_free_blocks();
+
+  auto block = allocator.allocate_block(64);
+
+  EXPECT_EQ(block, first);
+}
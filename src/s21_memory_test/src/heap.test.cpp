@@ -3,6 +3,8 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <cstddef>
+
 #include "s21_memory/block.hpp"
 
 using namespace testing;
@@ -14,3 +16,8 @@ TEST(heap_constructor, should_allocate_exact_size) {
 
   EXPECT_GE(size, s21::memory::word_size);
 }
+
+TEST(heap_constructor, should_not_store_deleter_state) {
+  EXPECT_EQ(sizeof(s21::memory::heap),
+            sizeof(std::size_t) + sizeof(s21::memory::raw_ptr));
+}
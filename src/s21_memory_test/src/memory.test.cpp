@@ -0,0 +1,300 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstring>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include "s21_memory.h"
+#include "s21_memory.hpp"
+#include "s21_memory/block.hpp"
+
+using namespace testing;
+
+TEST(s21_malloc, should_not_throw) {
+  static_assert(noexcept(s21_malloc(0)));
+  static_assert(noexcept(s21_calloc(0, 0)));
+  static_assert(noexcept(s21_realloc(nullptr, 0)));
+  static_assert(noexcept(s21_free(nullptr)));
+}
+
+TEST(s21_malloc, should_return_nullptr_if_out_of_memory) {
+  s21::set_heap(64);
+
+  EXPECT_EQ(s21_malloc(1024), nullptr);
+  EXPECT_NE(s21_malloc(16), nullptr);
+}
+
+TEST(s21_realloc, should_allocate_when_block_is_nullptr) {
+  s21::set_heap(64);
+
+  auto block = s21_realloc(nullptr, 16);
+
+  EXPECT_NE(block, nullptr);
+}
+
+TEST(s21_realloc, should_return_nullptr_when_resized_to_zero) {
+  s21::set_heap(64);
+
+  auto block = s21_malloc(16);
+
+  EXPECT_EQ(s21_realloc(block, 0), nullptr);
+}
+
+TEST(s21_realloc, should_keep_block_if_out_of_memory) {
+  s21::set_heap(64);
+
+  auto block = s21_malloc(8);
+
+  std::memcpy(block, "abcdefg", 8);
+
+  EXPECT_EQ(s21_realloc(block, 1024), nullptr);
+  EXPECT_STREQ(static_cast<char*>(block), "abcdefg");
+}
+
+TEST(s21_block_of, should_return_start_of_containing_block) {
+  s21::set_heap(256);
+
+  auto block = static_cast<char*>(s21_malloc(32));
+
+  EXPECT_EQ(s21_block_of(block + 17), block);
+  EXPECT_EQ(s21_block_of(nullptr), nullptr);
+
+  s21_free(block);
+
+  EXPECT_EQ(s21_block_of(block), nullptr);
+}
+
+TEST(s21_malloc, should_not_split_off_remainders_below_size_classes) {
+  s21::set_heap(256);
+  s21::set_size_classes({48});
+
+  auto block = s21_malloc(200);
+
+  EXPECT_EQ(s21::memory::header_of(block)->size, 256);
+
+  s21::set_heap(256);
+  s21::set_size_classes({});
+
+  block = s21_malloc(200);
+
+  EXPECT_EQ(s21::memory::header_of(block)->size, 200);
+
+  s21::set_size_classes({});
+}
+
+TEST(s21_import_size_classes, should_round_trip_exported_table) {
+  std::size_t table[] = {16, 40, 80};
+
+  ASSERT_TRUE(s21_import_size_classes(table, 3));
+
+  std::size_t exported[8];
+
+  EXPECT_EQ(s21_export_size_classes(exported, 8), 3);
+  EXPECT_THAT(std::vector(exported, exported + 3), ElementsAre(16, 40, 80));
+
+  EXPECT_FALSE(s21_import_size_classes(nullptr, 1));
+
+  s21::set_size_classes({});
+}
+
+TEST(s21_malloc_shared, should_free_block_with_last_reference) {
+  s21::set_heap(256);
+
+  auto block = s21_malloc_shared(32);
+
+  EXPECT_EQ(s21_retain(block), block);
+
+  s21_release(block);
+
+  EXPECT_EQ(s21_block_of(block), block);
+
+  s21_release(block);
+
+  EXPECT_EQ(s21_block_of(block), nullptr);
+}
+
+TEST(s21_malloc_shared, should_release_reference_on_free) {
+  s21::set_heap(256);
+
+  auto block = s21_malloc_shared(32);
+
+  s21_retain(block);
+  s21_free(block);
+
+  EXPECT_EQ(s21_block_of(block), block);
+
+  s21_free(block);
+
+  EXPECT_EQ(s21_block_of(block), nullptr);
+}
+
+TEST(s21_malloc_shared, should_not_reallocate_shared_block) {
+  s21::set_heap(256);
+
+  auto block = s21_malloc_shared(32);
+
+  EXPECT_EQ(s21_realloc(block, 64), nullptr);
+  EXPECT_EQ(s21_block_of(block), block);
+}
+
+TEST(s21_retain, should_reject_unshared_block) {
+  s21::set_heap(256);
+
+  auto block = s21_malloc(32);
+
+  EXPECT_EQ(s21_retain(block), nullptr);
+  EXPECT_FALSE(s21_freeze(block));
+
+  s21_release(block);
+
+  EXPECT_EQ(s21_block_of(block), block);
+}
+
+TEST(s21_freeze, should_mark_shared_block_read_only) {
+  s21::set_heap(256);
+
+  auto block = s21_malloc_shared(32);
+
+  EXPECT_FALSE(s21_is_frozen(block));
+  EXPECT_TRUE(s21_freeze(block));
+  EXPECT_TRUE(s21_is_frozen(block));
+  EXPECT_FALSE(s21_try_expand(block, 64));
+
+  s21_release(block);
+
+  auto reused = s21_malloc(32);
+
+  EXPECT_EQ(reused, block);
+  EXPECT_FALSE(s21_is_frozen(reused));
+}
+
+TEST(s21_malloc_shared, should_hand_off_block_between_threads) {
+  s21::set_heap(4096);
+
+  auto block = static_cast<int*>(s21_malloc_shared(sizeof(int) * 256));
+
+  for (auto i = 0; i < 256; i++) {
+    block[i] = i;
+  }
+
+  s21_freeze(block);
+
+  auto readers = std::vector<std::thread>();
+  auto sums = std::vector<int>(4);
+
+  for (auto i = 0; i < 4; i++) {
+    s21_retain(block);
+
+    readers.emplace_back([block, &sum = sums[i]] {
+      if (s21_is_frozen(block)) {
+        sum = std::accumulate(block, block + 256, 0);
+      }
+
+      s21_release(block);
+    });
+  }
+
+  for (auto& reader : readers) {
+    reader.join();
+  }
+
+  EXPECT_THAT(sums, Each(255 * 256 / 2));
+  EXPECT_EQ(s21_block_of(block), block);
+
+  s21_release(block);
+
+  EXPECT_EQ(s21_block_of(block), nullptr);
+}
+
+TEST(s21_malloc_shared, should_defer_free_released_on_worker_thread) {
+  s21::set_heap(256);
+
+  auto block = static_cast<int*>(s21_malloc_shared(sizeof(int)));
+
+  *block = 21;
+
+  auto worker = std::thread([block] {
+    EXPECT_EQ(*block, 21);
+
+    s21_release(block);
+  });
+
+  worker.join();
+
+  EXPECT_EQ(s21_block_of(block), block);
+
+  s21_trim();
+
+  EXPECT_EQ(s21_block_of(block), nullptr);
+  EXPECT_EQ(s21_malloc(sizeof(int)), block);
+}
+
+TEST(s21_malloc_purgeable, should_reclaim_unpinned_blocks_in_lru_order) {
+  s21::set_heap(320);
+
+  auto purged = std::vector<void*>();
+  auto callback = [](void* block, void* context) {
+    static_cast<std::vector<void*>*>(context)->push_back(block);
+  };
+
+  auto first = s21_malloc_purgeable(64, callback, &purged);
+  auto second = s21_malloc_purgeable(64, callback, &purged);
+  auto third = s21_malloc_purgeable(64, callback, &purged);
+
+  ASSERT_NE(third, nullptr);
+
+  s21_unpin(second);
+  s21_unpin(first);
+
+  EXPECT_NE(s21_malloc(64), nullptr);
+  EXPECT_THAT(purged, ElementsAre(second));
+
+  EXPECT_FALSE(s21_pin(second));
+  EXPECT_TRUE(s21_pin(first));
+  EXPECT_EQ(s21_malloc(64), nullptr);
+
+  s21_unpin(first);
+
+  EXPECT_NE(s21_malloc(64), nullptr);
+  EXPECT_THAT(purged, ElementsAre(second, first));
+  EXPECT_EQ(s21_block_of(third), third);
+}
+
+TEST(s21_malloc_purgeable, should_forget_freed_block) {
+  s21::set_heap(256);
+
+  auto block = s21_malloc_purgeable(64, nullptr, nullptr);
+
+  s21_unpin(block);
+  s21_free(block);
+
+  auto reused = s21_malloc(64);
+
+  EXPECT_EQ(reused, block);
+  EXPECT_FALSE(s21_pin(reused));
+  EXPECT_EQ(s21_realloc(reused, 128), reused);
+}
+
+TEST(s21_malloc_purgeable, should_not_reallocate_purgeable_block) {
+  s21::set_heap(256);
+
+  auto block = s21_malloc_purgeable(32, nullptr, nullptr);
+
+  EXPECT_EQ(s21_realloc(block, 64), nullptr);
+  EXPECT_EQ(s21_block_of(block), block);
+}
+
+TEST(s21_realloc, should_reclaim_purgeable_blocks_to_grow) {
+  s21::set_heap(256);
+
+  auto block = s21_malloc(32);
+  auto cached = s21_malloc_purgeable(64, nullptr, nullptr);
+
+  s21_unpin(cached);
+
+  EXPECT_NE(s21_realloc(block, 160), nullptr);
+  EXPECT_FALSE(s21_pin(cached));
+}
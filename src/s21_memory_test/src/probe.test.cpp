@@ -0,0 +1,91 @@
+#include "s21_memory/probe.hpp"
+
+#include <elf.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "s21_memory.h"
+
+using namespace testing;
+
+namespace {
+
+/**
+ * @brief Reads names of s21_memory SDT probes linked into current executable
+ */
+auto read_probe_names() -> std::set<std::string> {
+  auto file =
+      std::ifstream("/proc/self/exe", std::ios::binary | std::ios::ate);
+
+  auto image = std::vector<char>(static_cast<std::size_t>(file.tellg()));
+
+  file.seekg(0);
+  file.read(image.data(), static_cast<std::streamsize>(image.size()));
+
+  auto result = std::set<std::string>();
+
+  if (image.size() < sizeof(Elf64_Ehdr)) {
+    return result;
+  }
+
+  auto header = reinterpret_cast<const Elf64_Ehdr*>(image.data());
+  auto sections =
+      reinterpret_cast<const Elf64_Shdr*>(image.data() + header->e_shoff);
+  auto names = image.data() + sections[header->e_shstrndx].sh_offset;
+
+  for (auto i = 0; i < header->e_shnum; i++) {
+    if (std::strcmp(names + sections[i].sh_name, ".note.stapsdt") != 0) {
+      continue;
+    }
+
+    auto note = image.data() + sections[i].sh_offset;
+    auto end = note + sections[i].sh_size;
+
+    while (note < end) {
+      auto note_header = reinterpret_cast<const Elf64_Nhdr*>(note);
+
+      auto name_offset = sizeof(Elf64_Nhdr);
+      auto desc_offset = name_offset + (note_header->n_namesz + 3) / 4 * 4;
+
+      // Probe address, base address and semaphore address
+      auto provider = note + desc_offset + 3 * sizeof(Elf64_Addr);
+      auto probe = provider + std::strlen(provider) + 1;
+
+      if (std::strcmp(provider, "s21_memory") == 0) {
+        result.insert(probe);
+      }
+
+      note += desc_offset + (note_header->n_descsz + 3) / 4 * 4;
+    }
+  }
+
+  return result;
+}
+
+}  // namespace
+
+TEST(probe, should_be_present_in_linked_library) {
+#ifndef S21_MEMORY_PROBES_ENABLED
+  GTEST_SKIP() << "probes are compiled out";
+#endif
+
+  // Pulls memory.o out of the static library
+  s21_free(s21_malloc(1));
+
+  auto probes = read_probe_names();
+
+  auto expected = {"allocate", "free", "split", "merge", "realloc_in_place",
+                   "realloc_move", "out_of_memory", "set_heap",
+                   "malloc_failed", "realloc_failed"};
+
+  for (auto name : expected) {
+    EXPECT_EQ(probes.count(name), 1) << "missing probe " << name;
+  }
+}
@@ -0,0 +1,92 @@
+#include "s21_memory/purge_policy.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstring>
+
+#include "s21_memory/allocator.hpp"
+#include "s21_memory/block.hpp"
+
+using namespace testing;
+
+constexpr auto heap_size = 1024 * 1024;
+
+TEST(decay_purge, should_not_purge_before_decay_elapsed) {
+  auto allocator = s21::memory::allocator(heap_size);
+
+  auto block = allocator.allocate_block(heap_size / 2);
+
+  allocator.free_block(block);
+  allocator.free_block(allocator.allocate_block(0));
+
+  auto stats = allocator.stats();
+
+  EXPECT_EQ(stats.resident, stats.committed);
+}
+
+TEST(decay_purge, should_purge_pages_idle_for_a_whole_decay_period) {
+  auto allocator = s21::memory::allocator(heap_size);
+
+  allocator.purger().set_decay(std::chrono::milliseconds(0));
+
+  allocator.free_block(allocator.allocate_block(heap_size / 2));
+
+  auto resident = allocator.stats().resident;
+
+  EXPECT_GE(resident, heap_size / 2);
+
+  allocator.free_block(allocator.allocate_block(0));
+
+  EXPECT_LT(allocator.stats().resident, resident);
+}
+
+TEST(decay_purge, should_tick_on_allocation) {
+  auto allocator = s21::memory::allocator(heap_size);
+
+  allocator.purger().set_decay(std::chrono::milliseconds(0));
+
+  allocator.free_block(allocator.allocate_block(heap_size / 2));
+
+  auto resident = allocator.stats().resident;
+
+  allocator.allocate_block(0);
+  allocator.allocate_block(0);
+
+  EXPECT_LT(allocator.stats().resident, resident);
+}
+
+TEST(decay_purge, should_not_purge_pages_reused_since_previous_tick) {
+  auto allocator = s21::memory::allocator(heap_size);
+
+  allocator.purger().set_decay(std::chrono::milliseconds(0));
+
+  auto block = allocator.allocate_block(heap_size / 2);
+  auto other = allocator.allocate_block(0);
+
+  allocator.free_block(other);
+
+  auto keep = allocator.allocate_block(heap_size / 4);
+
+  allocator.free_block(allocator.allocate_block(0));
+
+  auto stats = allocator.stats();
+
+  EXPECT_GE(stats.resident, block->size + keep->size);
+}
+
+TEST(no_purge, should_keep_heap_resident) {
+  auto allocator =
+      s21::memory::basic_allocator<s21::memory::first_fit,
+                                   s21::memory::null_lock,
+                                   s21::memory::no_purge>(heap_size);
+
+  allocator.free_block(allocator.allocate_block(heap_size / 2));
+
+  allocator.trim();
+
+  auto stats = allocator.stats();
+
+  EXPECT_EQ(stats.resident, stats.committed);
+}
@@ -0,0 +1,65 @@
+#include "s21_memory/purgeable.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <array>
+
+#include "s21_memory/block.hpp"
+
+using namespace testing;
+
+TEST(purgeable_blocks, should_evict_least_recently_unpinned_first) {
+  auto headers = std::array<s21::memory::block_header, 3>{
+      {{s21::memory::block_type::char_t, 8},
+       {s21::memory::block_type::char_t, 8},
+       {s21::memory::block_type::char_t, 8}}};
+  auto blocks = s21::memory::purgeable_blocks();
+
+  for (auto& header : headers) {
+    blocks.add(&header, nullptr, nullptr);
+  }
+
+  EXPECT_FALSE(blocks.evict());
+
+  blocks.unpin(&headers[1]);
+  blocks.unpin(&headers[0]);
+  blocks.unpin(&headers[2]);
+
+  blocks.pin(&headers[1]);
+  blocks.unpin(&headers[1]);
+
+  EXPECT_EQ(blocks.evict()->block, &headers[0]);
+  EXPECT_EQ(blocks.evict()->block, &headers[2]);
+  EXPECT_EQ(blocks.evict()->block, &headers[1]);
+  EXPECT_FALSE(blocks.evict());
+  EXPECT_EQ(blocks.purged(), 3);
+}
+
+TEST(purgeable_blocks, should_nest_pins) {
+  auto header = s21::memory::block_header(s21::memory::block_type::char_t, 8);
+  auto blocks = s21::memory::purgeable_blocks();
+
+  blocks.add(&header, nullptr, nullptr);
+
+  EXPECT_TRUE(blocks.pin(&header));
+  EXPECT_TRUE(blocks.unpin(&header));
+  EXPECT_FALSE(blocks.evict());
+
+  EXPECT_TRUE(blocks.unpin(&header));
+  EXPECT_FALSE(blocks.unpin(&header));
+  EXPECT_EQ(blocks.evict()->block, &header);
+}
+
+TEST(purgeable_blocks, should_forget_removed_blocks) {
+  auto header = s21::memory::block_header(s21::memory::block_type::char_t, 8);
+  auto blocks = s21::memory::purgeable_blocks();
+
+  blocks.add(&header, nullptr, nullptr);
+  blocks.unpin(&header);
+  blocks.remove(&header);
+
+  EXPECT_FALSE(blocks.pin(&header));
+  EXPECT_FALSE(blocks.evict());
+  EXPECT_EQ(blocks.size(), 0);
+}
@@ -0,0 +1,94 @@
+#include "s21_memory/size_classes.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <vector>
+
+using namespace testing;
+
+TEST(size_classes, should_not_round_before_first_retune) {
+  auto classes = s21::memory::size_classes();
+
+  EXPECT_THAT(classes.table(), IsEmpty());
+  EXPECT_EQ(classes.round(0), 0);
+  EXPECT_EQ(classes.round(33), 40);
+  EXPECT_EQ(classes.round(65), 72);
+  EXPECT_EQ(classes.round(1000), 1000);
+  EXPECT_EQ(classes.split_threshold(), 0);
+}
+
+TEST(size_classes, should_retune_after_interval) {
+  auto classes = s21::memory::size_classes(4);
+
+  EXPECT_FALSE(classes.record(72));
+  EXPECT_FALSE(classes.record(72));
+  EXPECT_FALSE(classes.record(136));
+  EXPECT_TRUE(classes.record(136));
+
+  EXPECT_THAT(classes.table(), ElementsAre(72, 136));
+  EXPECT_EQ(classes.round(72), 72);
+  EXPECT_EQ(classes.round(100), 136);
+  EXPECT_EQ(classes.split_threshold(), 64);
+}
+
+TEST(size_classes, should_reduce_waste_of_clustered_sizes) {
+  auto classes = s21::memory::size_classes(0);
+
+  classes.set_table({8, 16, 32, 64, 128, 256, 512});
+
+  for (auto i = 0; i < 100; i++) {
+    for (auto size : {24, 40, 72, 136, 264, 264}) {
+      classes.record(size);
+    }
+  }
+
+  classes.retune();
+
+  auto stats = classes.stats();
+
+  EXPECT_EQ(stats.retunes, 1);
+  EXPECT_EQ(stats.requested, 100 * (24 + 40 + 72 + 136 + 264 + 264));
+  EXPECT_EQ(stats.before, 100 * (32 + 64 + 128 + 256 + 512 + 512));
+  EXPECT_EQ(stats.after, stats.requested);
+}
+
+TEST(size_classes, should_merge_bins_when_out_of_classes) {
+  auto classes = s21::memory::size_classes(0);
+
+  classes.set_table({8, 16, 32, 64, 128, 256, 512});
+
+  for (auto size = 8; size <= 80; size += 8) {
+    classes.record(size);
+  }
+
+  classes.retune();
+
+  EXPECT_EQ(classes.table().size(), s21::memory::size_classes::max_classes);
+  EXPECT_EQ(classes.table().back(), 80);
+  EXPECT_LT(classes.stats().after, classes.stats().before);
+}
+
+TEST(size_classes, should_import_valid_table) {
+  auto classes = s21::memory::size_classes();
+
+  EXPECT_TRUE(classes.set_table({24, 48, 96}));
+  EXPECT_THAT(classes.table(), ElementsAre(24, 48, 96));
+  EXPECT_EQ(classes.round(30), 48);
+
+  EXPECT_TRUE(classes.set_table({}));
+  EXPECT_EQ(classes.round(30), 32);
+}
+
+TEST(size_classes, should_reject_invalid_table) {
+  auto classes = s21::memory::size_classes();
+
+  EXPECT_FALSE(classes.set_table({48, 24}));
+  EXPECT_FALSE(classes.set_table({12}));
+  EXPECT_FALSE(classes.set_table({0}));
+  EXPECT_FALSE(classes.set_table({1024}));
+  EXPECT_FALSE(classes.set_table({8, 16, 24, 32, 40, 48, 56, 64, 72}));
+
+  EXPECT_THAT(classes.table(), IsEmpty());
+}
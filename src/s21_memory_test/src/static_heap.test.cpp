@@ -0,0 +1,70 @@
+#include "s21_memory/static_heap.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#include "s21_memory/allocator.hpp"
+#include "s21_memory/block.hpp"
+
+using namespace testing;
+
+namespace {
+
+s21::memory::static_allocator<1024> global_allocator;
+
+constexpr auto is_constant_initializable() {
+  auto allocator = s21::memory::static_allocator<64>();
+
+  static_cast<void>(allocator);
+
+  return true;
+}
+
+}  // namespace
+
+TEST(static_heap_constructor, should_be_constant_initializable) {
+  static_assert(is_constant_initializable());
+}
+
+TEST(static_heap_constructor, should_create_root_free_block) {
+  auto heap = s21::memory::static_heap<128>();
+
+  EXPECT_EQ(heap.root()->type, s21::memory::block_type::free);
+  EXPECT_EQ(s21::memory::block_size_of(heap.root()->size), heap.size());
+  EXPECT_EQ(reinterpret_cast<s21::memory::raw_ptr>(heap.root()), heap.data());
+}
+
+TEST(static_heap_constructor, should_align_storage) {
+  auto heap = s21::memory::static_heap<128>();
+
+  auto address = reinterpret_cast<std::uintptr_t>(heap.data());
+
+  EXPECT_EQ(address % alignof(std::max_align_t), 0);
+}
+
+TEST(static_allocator, should_allocate_from_inline_storage) {
+  auto begin = global_allocator.blocks().front();
+  auto end = reinterpret_cast<s21::memory::raw_ptr>(begin) +
+             global_allocator.size();
+
+  auto block = global_allocator.allocate_block(100);
+
+  EXPECT_GE(reinterpret_cast<s21::memory::raw_ptr>(block),
+            reinterpret_cast<s21::memory::raw_ptr>(begin));
+  EXPECT_LE(s21::memory::data_of(block) + block->size, end);
+
+  global_allocator.free_block(block);
+}
+
+TEST(static_allocator, should_work_on_stack) {
+  auto allocator = s21::memory::static_allocator<256>();
+
+  auto block = allocator.allocate_block(64);
+
+  EXPECT_EQ(block->size, 64);
+  EXPECT_THROW(allocator.allocate_block(256), std::bad_alloc);
+}